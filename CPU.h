@@ -1,14 +1,16 @@
 /// @author Jonathan Kelaty
 /// @file CS OS Home Project - CPU.h
 /// @date 2020-04-14
-/// @brief CPU class implementation. Only keeps track of the PID
-/// of the process currently being executed. CPU ready-queues are
-/// managed by OS class.
+/// @brief CPU class implementation. Each CPU is one core, and only
+/// keeps track of the PID of the process currently being executed and
+/// the NUMA node the core belongs to. CPU ready-queues are managed by
+/// OS class.
 
 #ifndef CPU_H_
 #define CPU_H_
 
 #include "DataTypes.h"
+#include "Checkpoint.h"
 
 /**************************************
  * 
@@ -19,6 +21,13 @@
 class CPU {
 
     public:
+        CPU(uint node = 0) :
+            NUMA_node{ node } { /* Intentionally empty */ }
+
+        uint getNode() const {
+            return NUMA_node;
+        }
+
         bool isRunning() const {
             return current_process;
         }
@@ -35,8 +44,17 @@ class CPU {
             current_process = 0;
         }
 
+        void saveState(CheckpointWriter & writer) const {
+            writer.write( current_process );
+        }
+
+        bool loadState(CheckpointReader & reader) {
+            return reader.read( current_process );
+        }
+
     private:
         PID current_process{ 0 };
+        uint NUMA_node{ 0 };
 
 };
 
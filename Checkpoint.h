@@ -0,0 +1,235 @@
+/// @author agent
+/// @file CS OS Home Project - Checkpoint.h
+/// @date 2026-10-18
+/// @brief Checkpoint image reader and writer. A checkpoint is a
+/// versioned binary image of the full simulator state, stored as a
+/// flat sequence of 32-bit words so it can be written in one pass and
+/// read back directly from a memory mapped file. Layout of each
+/// component is defined by its own saveState()/loadState() functions.
+
+#ifndef CHECKPOINT_H_
+#define CHECKPOINT_H_
+
+#include <cstdint>
+#include <cstring>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "DataTypes.h"
+
+// "OSCP" when read as little-endian bytes
+const std::uint32_t CHECKPOINT_MAGIC{ 0x5043534F };
+const std::uint32_t CHECKPOINT_VERSION{ 4 };
+
+/********************************
+ *
+ * Checkpoint Image Writer Class
+ *
+ ********************************/
+
+class CheckpointWriter {
+
+    public:
+        void write(std::uint32_t value) {
+            char bytes[sizeof(value)];
+            std::memcpy(bytes, &value, sizeof(value));
+            buffer.insert(buffer.end(), bytes, bytes + sizeof(value));
+        }
+
+        // Counters are stored as two words, low word first
+        void write(unsigned long long value) {
+            write( static_cast<std::uint32_t>(value) );
+            write( static_cast<std::uint32_t>(value >> 32) );
+        }
+
+        void write(const ReadyQueue & queue) {
+            write( static_cast<std::uint32_t>(queue.size()) );
+
+            for (PID process : queue) {
+                write( process );
+            }
+        }
+
+        /**
+         * Writes the image to a temporary file next to the destination
+         * and renames it into place, so an interrupted checkpoint never
+         * leaves a truncated image behind under the requested name.
+         *
+         * @param file_name Path of checkpoint file to write
+         *
+         * @return False if the image could not be written, else true
+         */
+        bool saveToFile(const std::string & file_name) const {
+            std::string temp_name{ file_name + ".tmp" };
+            std::FILE * file{ std::fopen(temp_name.c_str(), "wb") };
+
+            if ( ! file ) {
+                return false;
+            }
+
+            bool written{ std::fwrite(buffer.data(), 1, buffer.size(), file) == buffer.size() };
+            written = ( std::fclose(file) == 0 ) && written;
+
+            if ( ! written || std::rename(temp_name.c_str(), file_name.c_str()) != 0 ) {
+                std::remove( temp_name.c_str() );
+                return false;
+            }
+
+            return true;
+        }
+
+    private:
+        std::vector<char> buffer;
+
+};
+
+/********************************
+ *
+ * Checkpoint Image Reader Class
+ *
+ ********************************/
+
+class CheckpointReader {
+
+    public:
+        CheckpointReader() = delete;
+
+        CheckpointReader(const char * data, size_t size) :
+            cursor{ data }, end{ data + size } { /* Intentionally empty */ }
+
+        /**
+         * Reads the next word of the image. Once a read runs past the end
+         * of the image every following read fails as well, so callers may
+         * check good() once after reading a whole component.
+         *
+         * @param value Word read from the image
+         *
+         * @return False if image is exhausted, else true
+         */
+        bool read(std::uint32_t & value) {
+            if ( ! valid || static_cast<size_t>(end - cursor) < sizeof(value) ) {
+                valid = false;
+                return false;
+            }
+
+            std::memcpy(&value, cursor, sizeof(value));
+            cursor += sizeof(value);
+            return true;
+        }
+
+        bool read(unsigned long long & value) {
+            std::uint32_t low{ 0 };
+            std::uint32_t high{ 0 };
+
+            if ( ! read(low) || ! read(high) ) {
+                return false;
+            }
+
+            value = static_cast<unsigned long long>(high) << 32 | low;
+            return true;
+        }
+
+        bool read(ReadyQueue & queue) {
+            std::uint32_t count{ 0 };
+
+            // Reject counts that cannot possibly fit in the rest of the image
+            if ( ! read(count) || count > remainingWords() ) {
+                valid = false;
+                return false;
+            }
+
+            queue.clear();
+
+            for (std::uint32_t i{0}; i < count; ++i) {
+                std::uint32_t process{ 0 };
+                read( process );
+                queue.push_back( process );
+            }
+
+            return valid;
+        }
+
+        size_t remainingWords() const {
+            return static_cast<size_t>(end - cursor) / sizeof(std::uint32_t);
+        }
+
+        bool good() const {
+            return valid;
+        }
+
+        bool atEnd() const {
+            return cursor == end;
+        }
+
+    private:
+        const char * cursor;
+        const char * end;
+        bool valid{ true };
+
+};
+
+/*****************************************
+ *
+ * Read-Only Memory Mapped File Class
+ *
+ *****************************************/
+
+class MappedFile {
+
+    public:
+        MappedFile() = delete;
+        MappedFile(const MappedFile &) = delete;
+        MappedFile & operator=(const MappedFile &) = delete;
+
+        MappedFile(const std::string & file_name) {
+            int fd{ ::open(file_name.c_str(), O_RDONLY) };
+
+            if ( fd < 0 ) {
+                return;
+            }
+
+            struct stat info;
+
+            if ( ::fstat(fd, &info) == 0 && info.st_size > 0 ) {
+                void * mapping{ ::mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0) };
+
+                if ( mapping != MAP_FAILED ) {
+                    mapped_data = static_cast<const char *>(mapping);
+                    mapped_size = static_cast<size_t>(info.st_size);
+                }
+            }
+
+            ::close(fd);
+        }
+
+        ~MappedFile() {
+            if ( mapped_data ) {
+                ::munmap(const_cast<char *>(mapped_data), mapped_size);
+            }
+        }
+
+        bool isOpen() const {
+            return mapped_data;
+        }
+
+        const char * data() const {
+            return mapped_data;
+        }
+
+        size_t size() const {
+            return mapped_size;
+        }
+
+    private:
+        const char * mapped_data{ nullptr };
+        size_t mapped_size{ 0 };
+
+};
+
+#endif // CHECKPOINT_H_
@@ -0,0 +1,229 @@
+/// @author agent
+/// @file CS OS Home Project - CheckpointTest.cpp
+/// @date 2026-10-18
+/// @brief Checks that checkpoint restore rejects inconsistent images.
+/// Each test saves a real checkpoint, patches words of the image, and
+/// checks that the patched image is rejected and leaves the current
+/// state untouched, while the unpatched image still restores. Run with
+/// "make test".
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "DataTypes.h"
+#include "OS.h"
+
+typedef std::vector<std::uint32_t> Image;
+
+const char * const CHECKPOINT_PATH{ "checkpoint_test.cp" };
+
+// Words after the process table (NUMA and memory sharing counters), and
+// words per process record (PID, type, start, end, last node)
+const size_t STATISTICS_WORDS{ 14 };
+const size_t PROCESS_WORDS{ 5 };
+
+// Position of the first free block's start address in the RAM state
+const size_t FIRST_FREE_BLOCK{ 6 };
+
+Image readImage(const std::string & file_name) {
+    std::ifstream file( file_name, std::ios::binary );
+    std::vector<char> bytes{ std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+    Image image( bytes.size() / sizeof(std::uint32_t) );
+
+    std::copy(bytes.begin(), bytes.begin() + image.size() * sizeof(std::uint32_t),
+              reinterpret_cast<char *>(image.data()));
+    return image;
+}
+
+void writeImage(const std::string & file_name, const Image & image) {
+    std::ofstream file( file_name, std::ios::binary | std::ios::trunc );
+    file.write( reinterpret_cast<const char *>(image.data()), image.size() * sizeof(std::uint32_t) );
+}
+
+/**
+ * @param image Checkpoint image
+ * @param process Index of process record (in PID order)
+ * @param process_count Number of processes in the image
+ *
+ * @return Position of the process record's first word
+ */
+size_t processRecord(const Image & image, size_t process, size_t process_count) {
+    return image.size() - STATISTICS_WORDS - PROCESS_WORDS * (process_count - process);
+}
+
+/**
+ * Saves a checkpoint of os, lets patch change the image, and restores
+ * the patched image.
+ *
+ * @param os OS to checkpoint and restore
+ * @param patch Changes the image
+ *
+ * @return Status of the restore
+ */
+template <typename Patch>
+Status loadPatched(OS & os, Patch patch) {
+    if ( os.saveCheckpoint(CHECKPOINT_PATH) != Status::Ok ) {
+        return Status::CheckpointWriteFailed;
+    }
+
+    Image image{ readImage(CHECKPOINT_PATH) };
+
+    patch( image, os.getProcesses().size() );
+    writeImage(CHECKPOINT_PATH, image);
+
+    return os.loadCheckpoint(CHECKPOINT_PATH);
+}
+
+/**
+ * Saves a checkpoint of os, lets patch change the image, and checks the
+ * patched image is rejected without touching os while the original one
+ * restores.
+ *
+ * @param os OS to checkpoint
+ * @param patch Changes the image into an inconsistent one
+ *
+ * @return Empty string if the images are handled as expected, else the
+ * problem
+ */
+template <typename Patch>
+std::string checkRejected(OS & os, Patch patch) {
+    if ( os.saveCheckpoint(CHECKPOINT_PATH) != Status::Ok ) {
+        return "could not save checkpoint";
+    }
+
+    Image image{ readImage(CHECKPOINT_PATH) };
+    Image patched{ image };
+    size_t process_count{ os.getProcesses().size() };
+
+    patch( patched, process_count );
+    writeImage(CHECKPOINT_PATH, patched);
+
+    if ( os.loadCheckpoint(CHECKPOINT_PATH) != Status::CheckpointReadFailed ) {
+        return "patched image was restored";
+    }
+
+    if ( os.getProcesses().size() != process_count ) {
+        return "rejected image changed the process table";
+    }
+
+    writeImage(CHECKPOINT_PATH, image);
+
+    if ( os.loadCheckpoint(CHECKPOINT_PATH) != Status::Ok ) {
+        return "original image was rejected";
+    }
+
+    return "";
+}
+
+/**
+ * RAM of 20 with processes [0,4] and [5,9]. Moving the second process to
+ * [3,9] overlaps the first one, and moving it to [6,9] leaves a gap. A
+ * forked process sharing the first block exactly is still accepted.
+ *
+ * @return Empty string if the images are handled as expected, else the
+ * problem
+ */
+std::string testBlockLayout() {
+    OS os(20, 0);
+    PID forked_ID{ 0 };
+
+    os.createNewProcess(ProcessType::Common, 5);
+    os.createNewProcess(ProcessType::Common, 5);
+
+    std::string problem{ checkRejected(os, [](Image & image, size_t process_count) {
+        image[processRecord(image, 1, process_count) + 2] = 3;
+    }) };
+
+    if ( problem.empty() ) {
+        problem = checkRejected(os, [](Image & image, size_t process_count) {
+            image[processRecord(image, 1, process_count) + 2] = 6;
+        });
+    }
+
+    if ( problem.empty() && os.forkProcess(1, &forked_ID) != Status::Ok ) {
+        problem = "could not fork";
+    }
+
+    if ( problem.empty() ) {
+        // The forked process' block overlaps the parent's without being
+        // identical to it
+        problem = checkRejected(os, [](Image & image, size_t process_count) {
+            image[processRecord(image, 2, process_count) + 3] = 3;
+        });
+    }
+
+    if ( problem.empty() && os.getSharedRegions().size() != 1 ) {
+        problem = "shared block was not restored";
+    }
+
+    return problem;
+}
+
+/**
+ * RAM of 20 on two NUMA nodes ([0,9] and [10,19]) with processes [0,4]
+ * and [5,9]. Growing the second process to [5,14] (and shrinking the
+ * free block to [15,19]) still tiles the RAM, but the block crosses
+ * into node 1. The same image is accepted when the RAM is one node.
+ *
+ * @return Empty string if the images are handled as expected, else the
+ * problem
+ */
+std::string testZoneCrossing() {
+    auto cross_nodes = [](Image & image, size_t process_count) {
+        image[processRecord(image, 1, process_count) + 3] = 14;
+        image[FIRST_FREE_BLOCK] = 15;
+    };
+
+    OS os(20, 0, 2);
+    os.createNewProcess(ProcessType::Common, 5);
+    os.createNewProcess(ProcessType::Common, 5);
+
+    std::string problem{ checkRejected(os, cross_nodes) };
+
+    if ( ! problem.empty() ) {
+        return problem;
+    }
+
+    OS single_node(20, 0);
+    single_node.createNewProcess(ProcessType::Common, 5);
+    single_node.createNewProcess(ProcessType::Common, 5);
+
+    if ( loadPatched(single_node, cross_nodes) != Status::Ok ) {
+        return "block on a single node was rejected";
+    }
+
+    if ( single_node.getProcesses().at(2).getMemoryBlock() != MemoryBlock(5, 14) ) {
+        return "block on a single node was not restored";
+    }
+
+    return "";
+}
+
+int main() {
+    std::string problem{ testBlockLayout() };
+
+    if ( ! problem.empty() ) {
+        std::cout << "FAIL checkpoint block layout, " << problem << std::endl;
+        std::remove( CHECKPOINT_PATH );
+        return 1;
+    }
+
+    std::cout << "PASS checkpoint block layout" << std::endl;
+
+    problem = testZoneCrossing();
+    std::remove( CHECKPOINT_PATH );
+
+    if ( ! problem.empty() ) {
+        std::cout << "FAIL checkpoint NUMA zones, " << problem << std::endl;
+        return 1;
+    }
+
+    std::cout << "PASS checkpoint NUMA zones" << std::endl;
+    return 0;
+}
@@ -0,0 +1,152 @@
+/// @author agent
+/// @file CS OS Home Project - CommandQueue.h
+/// @date 2026-10-18
+/// @brief CommandQueue class implementation. Bounded lock-free ring
+/// buffer of console commands with many producers and a single consumer.
+/// Every slot carries a sequence number telling whose turn it is: a
+/// producer claims a slot with one compare-and-swap on the enqueue
+/// position and publishes it by advancing the slot's sequence, and the
+/// consumer frees it the same way. Neither side ever takes a lock, and a
+/// full queue is reported to the producer instead of blocking it.
+
+#ifndef COMMAND_QUEUE_H_
+#define COMMAND_QUEUE_H_
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include "DataTypes.h"
+
+// Longest command line (including terminating null) a producer can submit
+const size_t COMMAND_TEXT_SIZE{ 120 };
+
+// Command submitted by a producer. Ticks are strictly increasing for each
+// producer, so (tick, producer) orders all commands uniquely
+struct Command {
+    std::uint64_t tick;
+    uint producer;
+    char text[COMMAND_TEXT_SIZE];
+};
+
+/**********************
+ *
+ * Command Queue Class
+ *
+ **********************/
+
+class CommandQueue {
+
+    public:
+        CommandQueue() = delete;
+        CommandQueue(const CommandQueue &) = delete;
+        CommandQueue & operator=(const CommandQueue &) = delete;
+
+        /**
+         * Capacity is rounded up to a power of two so positions can be
+         * mapped to slots with a mask.
+         *
+         * @param capacity Minimum number of commands the queue can hold
+         */
+        CommandQueue(size_t capacity) :
+            slots( roundUpToPowerOfTwo(capacity) ), mask{ slots.size() - 1 }
+        {
+            for (size_t i{0}; i < slots.size(); ++i) {
+                slots[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        /**
+         * Appends a command. Safe to call from any number of threads.
+         *
+         * @param command Command to append
+         *
+         * @return False if the queue is full, else true
+         */
+        bool tryPush(const Command & command) {
+            size_t position{ enqueue_position.load(std::memory_order_relaxed) };
+
+            while ( true ) {
+                Slot & slot{ slots[position & mask] };
+                size_t sequence{ slot.sequence.load(std::memory_order_acquire) };
+
+                if ( sequence == position ) {
+                    // Slot is free for this position, try to claim it
+                    if ( enqueue_position.compare_exchange_weak(position, position + 1,
+                            std::memory_order_relaxed) ) {
+                        slot.command = command;
+                        slot.sequence.store(position + 1, std::memory_order_release);
+                        return true;
+                    }
+                }
+                else if ( sequence < position ) {
+                    // Slot still holds the command from one lap earlier
+                    return false;
+                }
+                else {
+                    // Another producer claimed this position first
+                    position = enqueue_position.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        /**
+         * Removes the oldest published command. Must only be called from
+         * the single consumer thread.
+         *
+         * @param command Command removed from the queue
+         *
+         * @return False if no command is published yet, else true
+         */
+        bool tryPop(Command & command) {
+            Slot & slot{ slots[dequeue_position & mask] };
+
+            if ( slot.sequence.load(std::memory_order_acquire) != dequeue_position + 1 ) {
+                return false;
+            }
+
+            command = slot.command;
+            slot.sequence.store(dequeue_position + slots.size(), std::memory_order_release);
+            ++dequeue_position;
+            return true;
+        }
+
+        /**
+         * Number of claimed slots, including ones still being written.
+         * Only meaningful on the consumer thread.
+         */
+        size_t size() const {
+            return enqueue_position.load(std::memory_order_relaxed) - dequeue_position;
+        }
+
+        size_t capacity() const {
+            return slots.size();
+        }
+
+    private:
+        struct Slot {
+            std::atomic<size_t> sequence{ 0 };
+            Command command;
+        };
+
+        static size_t roundUpToPowerOfTwo(size_t value) {
+            size_t power{ 1 };
+
+            while ( power < value ) {
+                power <<= 1;
+            }
+
+            return power;
+        }
+
+        std::vector<Slot> slots;
+        const size_t mask;
+
+        // Producers and consumer advance these concurrently, keep them on
+        // separate cache lines
+        alignas(64) std::atomic<size_t> enqueue_position{ 0 };
+        alignas(64) size_t dequeue_position{ 0 };
+
+};
+
+#endif // COMMAND_QUEUE_H_
@@ -0,0 +1,762 @@
+/// @author agent, from the console loop by Jonathan Kelaty
+/// @file CS OS Home Project - Console.cpp
+/// @date 2026-10-18
+/// @brief Console class implementation. Implementation details
+/// can be found in function documentation below.
+
+#include <iostream>
+#include <istream>
+#include <string>
+#include <unordered_map>
+
+#include "DataTypes.h"
+#include "Console.h"
+
+using std::cout;
+using std::cin;
+using std::istream;
+using std::endl;
+using std::string;
+using std::unordered_map;
+
+// Operations that can be performed by OS
+enum class Operation { A, AR, F, W, Q, t, d, D, c, S, SJ, C, L, TR };
+
+// Snapshot commands that can be performed by OS
+enum class Snapshot { r, i, m, s, l, n, a, dr, di, dm };
+
+// Operation lookup hash table
+const unordered_map<string, Operation> OPERATIONS {
+    {"A",  Operation::A},
+    {"AR", Operation::AR},
+    {"F",  Operation::F},
+    {"W",  Operation::W},
+    {"Q",  Operation::Q},
+    {"t",  Operation::t},
+    {"d",  Operation::d},
+    {"D",  Operation::D},
+    {"c",  Operation::c},
+    {"S",  Operation::S},
+    {"SJ", Operation::SJ},
+    {"C",  Operation::C},
+    {"L",  Operation::L},
+    {"TR", Operation::TR}
+};
+
+// Snapshot lookup hash table
+const unordered_map<string, Snapshot> SNAPSHOTS {
+    {"r",  Snapshot::r},
+    {"i",  Snapshot::i},
+    {"m",  Snapshot::m},
+    {"s",  Snapshot::s},
+    {"l",  Snapshot::l},
+    {"n",  Snapshot::n},
+    {"a",  Snapshot::a},
+    {"dr", Snapshot::dr},
+    {"di", Snapshot::di},
+    {"dm", Snapshot::dm}
+};
+
+/**
+ * Reads in argument for a given operation and determines if the input
+ * is valid (is an unsigned integer). If not, the input stream is cleared
+ * and the rest of the line is ignored. Error is then output to indicate
+ * this was an invalid argument.
+ * 
+ * @param input Stream the command is read from
+ * @param arg Unsigned integer argument to read in
+ * 
+ * @return False if invalid argument, else true
+ */
+bool isValidOperationArgument(istream & input, uint & arg) {
+    if ( ! (input >> arg) ) {
+        cout << "\n\tError - Invalid argument\n" << endl;
+        input.clear();
+        input.ignore(256, '\n');
+        return false;
+    }
+    else {
+        return true;
+    }
+}
+
+/**
+ * Outputs the header of a snapshot. JSON Lines snapshots have no header,
+ * every record is self-describing.
+ *
+ * @param format Text table or JSON Lines
+ * @param header Column header of text table
+ */
+void beginSnapshot(SnapshotFormat format, const char * header) {
+    if ( format == SnapshotFormat::Text ) {
+        cout << header;
+    }
+}
+
+/**
+ * Ends a snapshot and flushes it. JSON Lines snapshots end with a summary
+ * record, so tooling can tell where a snapshot (even an empty delta) ends.
+ *
+ * @param format Text table or JSON Lines
+ * @param view Snapshot view ("r", "i", "m" or "l")
+ * @param delta Whether the snapshot only contains changed processes
+ * @param records Number of records output
+ */
+void endSnapshot(SnapshotFormat format, const char * view, bool delta, size_t records) {
+    if ( format == SnapshotFormat::Text ) {
+        cout << '\n';
+    }
+    else {
+        cout << "{\"snapshot\":\"" << view << "\",\"delta\":" << (delta ? "true" : "false")
+             << ",\"records\":" << records << "}\n";
+    }
+
+    cout << std::flush;
+}
+
+/**
+ * Outputs the error message of a failed operation. Successful operations
+ * are silent.
+ *
+ * @param status Status returned by the operation
+ * @param detail Optional detail appended to the message (e.g. file name)
+ */
+void reportStatus(Status status, const string & detail = "") {
+    if ( status == Status::Ok ) {
+        return;
+    }
+
+    cout << "\n\tError - " << statusMessage(status);
+
+    if ( ! detail.empty() ) {
+        cout << ": " << detail;
+    }
+
+    cout << '\n' << endl;
+}
+
+/**
+ * Simulates the operating system by prompting the user to enter commands
+ * to create or interact with processes used by the CPU and IO devices.
+ * Runs until the input stream ends.
+ */
+void Console::run() {
+    while ( true ) {
+
+        cout << ">> ";
+
+        if ( ! runCommand(cin, current_core) ) {
+            break;
+        }
+
+    }
+}
+
+/**
+ * Reads one command from the input stream and performs it. Input is
+ * sanitized to make sure we don't encounter errors during execution.
+ * Operations that can be performed by the user:
+ * 
+ *  A <#>  - Creates new common process of size #
+ *  AR <#> - Creates new real-time process of size #
+ *  F <#>  - Forks process #, sharing its memory until written
+ *  W <#>  - Writes to memory of process #, copying it if shared
+ *  Q      - Ends time slice of currently executing process
+ *  t      - Terminates currently executing process
+ *  d <#>  - Send currently running process to hard disk #
+ *  D <#>  - Send process being served by hard disk # to ready-queue
+ *  c <#>  - Select core # that A, AR, Q, t and d apply to
+ *  S r    - Snapshot of CPU and ready-queues
+ *  S i    - Snapshot of IO devices and their IO-queues
+ *  S m    - Snapshot of RAM
+ *  S s    - Snapshot of shared memory regions and sharing savings
+ *  S l    - Snapshot of operation latencies
+ *  S n    - Snapshot of NUMA nodes and locality statistics
+ *  S a    - Snapshot of internal memory pool allocations
+ *  S dr   - Delta snapshot of CPU and ready-queues
+ *  S di   - Delta snapshot of IO devices and their IO-queues
+ *  S dm   - Delta snapshot of RAM
+ *  SJ <s> - Any snapshot above, in JSON Lines form
+ *  C <f>  - Checkpoint full simulator state to file f
+ *  L <f>  - Restore simulator state from checkpoint file f
+ *  TR <f> - Start tracing events to Chrome trace file f
+ *  TR off - Stop tracing and finish the trace file
+ *
+ * @param input Stream the command is read from
+ * @param core Selected core, updated by the c operation
+ *
+ * @return False if the input stream ended before a command, else true
+ */
+bool Console::runCommand(istream & input, uint & core) {
+    string operation{ "" };
+    string snapshot{ "" };
+    string file_name{ "" };
+    uint uint_arg{ 0 };
+    SnapshotFormat snapshot_format{ SnapshotFormat::Text };
+
+    if ( ! (input >> operation) ) {
+        return false;
+    }
+
+    // Check if valid operation
+    if ( ! OPERATIONS.count(operation) ) {
+        cout << "\n\tError - Invalid operation: " << operation << '\n' << endl;
+        input.clear();
+        input.ignore(256, '\n');
+        return true;
+    }
+
+    switch ( OPERATIONS.at(operation) ) {
+        case Operation::A: // Create new common process
+
+            if ( isValidOperationArgument(input, uint_arg) ) {
+                reportStatus( os.createNewProcess(ProcessType::Common, uint_arg, nullptr, core) );
+            }
+            break;
+
+        case Operation::AR: // Create new RT process
+
+            if ( isValidOperationArgument(input, uint_arg) ) {
+                reportStatus( os.createNewProcess(ProcessType::RealTime, uint_arg, nullptr, core) );
+            }
+            break;
+
+        case Operation::F: // Fork process
+
+            if ( isValidOperationArgument(input, uint_arg) ) {
+                reportStatus( os.forkProcess(uint_arg) );
+            }
+            break;
+
+        case Operation::W: // Write to process' memory
+
+            if ( isValidOperationArgument(input, uint_arg) ) {
+                reportStatus( os.writeProcessMemory(uint_arg) );
+            }
+            break;
+
+        case Operation::Q: // End time slice for currently running process
+
+            reportStatus( os.executeNextProcess(core) );
+            break;
+
+        case Operation::t: // Terminate currently running process
+
+            reportStatus( os.terminateCurrentProcess(core) );
+            break;
+
+        case Operation::d: // Send currently running process to IO Queue
+
+            if ( isValidOperationArgument(input, uint_arg) ) {
+                reportStatus( os.sendCurrentProcesstoIOQueue(uint_arg, core) );
+            }
+            break;
+
+        case Operation::D: // Send process back form IO to ready-queue
+
+            if ( isValidOperationArgument(input, uint_arg) ) {
+                reportStatus( os.sendIOProcessToReadyQueue(uint_arg) );
+            }
+            break;
+
+        case Operation::c: // Select core for process operations
+
+            if ( isValidOperationArgument(input, uint_arg) ) {
+                if ( uint_arg < os.getCPUs().size() ) {
+                    core = uint_arg;
+                }
+                else {
+                    reportStatus( Status::InvalidCore );
+                }
+            }
+            break;
+
+        case Operation::S: // Snapshot command
+        case Operation::SJ:
+
+            input >> snapshot;
+
+            // Check if valid snapshot
+            if ( ! SNAPSHOTS.count(snapshot) ) {
+                cout << "\n\tError - Invalid snapshot: " << snapshot << '\n' << endl;
+                input.clear();
+                input.ignore(256, '\n');
+                return true;
+            }
+            
+            snapshot_format = ( OPERATIONS.at(operation) == Operation::SJ ?
+                SnapshotFormat::JSON : SnapshotFormat::Text );
+
+            switch( SNAPSHOTS.at(snapshot) ) {
+                case Snapshot::r: // Print CPU ready-queue data
+                    printCPUData(snapshot_format, false);
+                    break;
+                case Snapshot::i: // Print IO-queue data
+                    printIOData(snapshot_format, false);
+                    break;
+                case Snapshot::m: // Print RAM data
+                    printRAMData(snapshot_format, false);
+                    break;
+                case Snapshot::s: // Print shared memory data
+                    printSharingData(snapshot_format);
+                    break;
+                case Snapshot::l: // Print operation latency data
+                    printLatencyData(snapshot_format);
+                    break;
+                case Snapshot::n: // Print NUMA data
+                    printNUMAData(snapshot_format);
+                    break;
+                case Snapshot::a: // Print memory pool allocation data
+                    printAllocationData(snapshot_format);
+                    break;
+                case Snapshot::dr: // Print changed CPU ready-queue data
+                    printCPUData(snapshot_format, true);
+                    break;
+                case Snapshot::di: // Print changed IO-queue data
+                    printIOData(snapshot_format, true);
+                    break;
+                case Snapshot::dm: // Print changed RAM data
+                    printRAMData(snapshot_format, true);
+                    break;
+            }
+            break;
+
+        case Operation::C: // Checkpoint simulator state
+
+            input >> file_name;
+
+            reportStatus( os.saveCheckpoint(file_name), file_name );
+            break;
+
+        case Operation::L: // Restore simulator state from checkpoint
+
+            input >> file_name;
+
+            reportStatus( os.loadCheckpoint(file_name), file_name );
+            break;
+
+        case Operation::TR: // Start or stop event tracing
+
+            input >> file_name;
+
+            if ( file_name == "off" ) {
+                os.stopTrace();
+            }
+            else {
+                reportStatus( os.startTrace(file_name), file_name );
+            }
+            break;
+    }
+
+    return true;
+}
+
+/**
+ * Outputs the CPU and its ready-queues: the running processes first (in
+ * core order), then the RT and common ready-queues in order. With more
+ * than one core, a CORE column shows where each process is running. A
+ * delta snapshot only lists processes whose CPU state changed since the
+ * last CPU snapshot; those that have left the CPU (sent to a HDD or
+ * terminated) are "Removed".
+ * Output is written with '\n' and flushed once at the end, so large
+ * snapshots go out in buffer-sized writes rather than one per line.
+ *
+ * @param format Text table or JSON Lines
+ * @param delta Only output processes changed since last snapshot
+ */
+void Console::printCPUData(SnapshotFormat format, bool delta) {
+    bool full{ ! delta };
+    const DirtyList & changed{ os.takeDirtyProcesses(SnapshotView::CPU, full) };
+    size_t records{ 0 };
+
+    beginSnapshot(format, os.getCPUs().size() > 1 ? "\n\tPID\tTYPE\tSTATUS\tCORE\n" : "\n\tPID\tTYPE\tSTATUS\n");
+
+    if ( full ) {
+        // Output cores' currently running processes first if they're running
+        for (const CPU & processor : os.getCPUs()) {
+            if ( processor.isRunning() ) {
+                writeCPURecord(format, processor.currentProcessPID());
+                ++records;
+            }
+        }
+
+        // Output RT ready-queue, then common ready-queue
+        for (const ReadyQueue * queue : { &os.getRTQueue(), &os.getCommonQueue() }) {
+            for (PID process : *queue) {
+                writeCPURecord(format, process);
+            }
+
+            records += queue->size();
+        }
+    }
+    else {
+        for (PID process : changed) {
+            writeCPURecord(format, process);
+        }
+
+        records = changed.size();
+    }
+
+    endSnapshot(format, "r", ! full, records);
+}
+
+/**
+ * Outputs every HDD's served process followed by its IO-queue. A delta
+ * snapshot only lists processes whose IO state changed since the last IO
+ * snapshot; those that have left the HDDs are "Removed".
+ *
+ * @param format Text table or JSON Lines
+ * @param delta Only output processes changed since last snapshot
+ */
+void Console::printIOData(SnapshotFormat format, bool delta) {
+    bool full{ ! delta };
+    const DirtyList & changed{ os.takeDirtyProcesses(SnapshotView::IO, full) };
+    size_t records{ 0 };
+
+    beginSnapshot(format, "\n\tPID\tHDD\tSTATUS\n");
+
+    if ( full ) {
+        for (const HDD & hard_drive : os.getHardDrives()) {
+            // Output HDD's current process first if it's serving
+            if ( hard_drive.isServing() ) {
+                writeIORecord(format, hard_drive.currentProcessPID());
+                ++records;
+            }
+
+            // Output HDD's IO-queue
+            for (PID process : hard_drive.getIOQueue()) {
+                writeIORecord(format, process);
+            }
+
+            records += hard_drive.getIOQueue().size();
+        }
+    }
+    else {
+        for (PID process : changed) {
+            writeIORecord(format, process);
+        }
+
+        records = changed.size();
+    }
+
+    endSnapshot(format, "i", ! full, records);
+}
+
+/**
+ * Outputs processes (in order of PID) and their starting and ending
+ * memory addresses. A delta snapshot only lists processes created or
+ * terminated since the last RAM snapshot; terminated ones are "Freed",
+ * or "Released" if their block is still shared by forked processes.
+ *
+ * @param format Text table or JSON Lines
+ * @param delta Only output processes changed since last snapshot
+ */
+void Console::printRAMData(SnapshotFormat format, bool delta) {
+    bool full{ ! delta };
+    const DirtyList & changed{ os.takeDirtyProcesses(SnapshotView::RAM, full) };
+    size_t records{ 0 };
+
+    beginSnapshot(format, "\n\tPID\tM_START\tM_END\n");
+
+    if ( full ) {
+        for (const auto & process : os.getProcesses()) {
+            writeRAMRecord(format, process.first);
+        }
+
+        records = os.getProcesses().size();
+    }
+    else {
+        for (PID process : changed) {
+            writeRAMRecord(format, process);
+        }
+
+        records = changed.size();
+    }
+
+    endSnapshot(format, "m", ! full, records);
+}
+
+void Console::writeCPURecord(SnapshotFormat format, PID process_ID) const {
+    auto process{ os.getProcesses().find( process_ID ) };
+    const char * process_type{ nullptr };
+    const char * status{ "Removed" };
+    bool running{ false };
+
+    if ( process != os.getProcesses().end() ) {
+        process_type = ( process->second.getProcessType() == ProcessType::Common ? "Common" : "RT" );
+
+        if ( process->second.getProcessState() == ProcessState::Running ) {
+            running = true;
+            status = "Running";
+        }
+        else if ( process->second.getProcessState() == ProcessState::Ready ) {
+            status = "Waiting";
+        }
+    }
+
+    if ( format == SnapshotFormat::Text ) {
+        cout << '\t' << process_ID << '\t' << (process_type ? process_type : "-") << '\t' << status;
+
+        if ( os.getCPUs().size() > 1 ) {
+            cout << '\t';
+
+            if ( running ) {
+                cout << process->second.getDevice();
+            }
+            else {
+                cout << '-';
+            }
+        }
+
+        cout << '\n';
+    }
+    else {
+        cout << "{\"snapshot\":\"r\",\"pid\":" << process_ID;
+
+        if ( process_type ) {
+            cout << ",\"type\":\"" << process_type << '"';
+        }
+
+        cout << ",\"status\":\"" << status << '"';
+
+        if ( running ) {
+            cout << ",\"core\":" << process->second.getDevice();
+        }
+
+        cout << "}\n";
+    }
+}
+
+void Console::writeIORecord(SnapshotFormat format, PID process_ID) const {
+    auto process{ os.getProcesses().find( process_ID ) };
+    bool in_IO{ false };
+    const char * status{ "Removed" };
+
+    if ( process != os.getProcesses().end() ) {
+        if ( process->second.getProcessState() == ProcessState::IOServing ) {
+            in_IO = true;
+            status = "Serving";
+        }
+        else if ( process->second.getProcessState() == ProcessState::IOWaiting ) {
+            in_IO = true;
+            status = "Waiting";
+        }
+    }
+
+    if ( format == SnapshotFormat::Text ) {
+        cout << '\t' << process_ID << '\t';
+
+        if ( in_IO ) {
+            cout << process->second.getDevice();
+        }
+        else {
+            cout << '-';
+        }
+
+        cout << '\t' << status << '\n';
+    }
+    else {
+        cout << "{\"snapshot\":\"i\",\"pid\":" << process_ID;
+
+        if ( in_IO ) {
+            cout << ",\"hdd\":" << process->second.getDevice();
+        }
+
+        cout << ",\"status\":\"" << status << "\"}\n";
+    }
+}
+
+void Console::writeRAMRecord(SnapshotFormat format, PID process_ID) const {
+    auto process{ os.getProcesses().find( process_ID ) };
+
+    if ( process == os.getProcesses().end() ) {
+        const char * status{ os.isMemoryBlockKept(process_ID) ? "Released" : "Freed" };
+
+        if ( format == SnapshotFormat::Text ) {
+            cout << '\t' << process_ID << "\t-\t-\t" << status << '\n';
+        }
+        else {
+            cout << "{\"snapshot\":\"m\",\"pid\":" << process_ID << ",\"status\":\"" << status << "\"}\n";
+        }
+
+        return;
+    }
+
+    const MemoryBlock & memory{ process->second.getMemoryBlock() };
+
+    if ( format == SnapshotFormat::Text ) {
+        cout << '\t' << process_ID << '\t' << memory.first << '\t' << memory.second << '\n';
+    }
+    else {
+        cout << "{\"snapshot\":\"m\",\"pid\":" << process_ID
+             << ",\"m_start\":" << memory.first << ",\"m_end\":" << memory.second << "}\n";
+    }
+}
+
+/**
+ * Outputs every memory region shared by forked processes (with how many
+ * processes share it), then the RAM accounting: bytes private to one
+ * process, bytes of shared regions, bytes mapped by all processes, and
+ * the bytes saved by sharing instead of copying, along with the number
+ * of forks and copy-on-write splits so far.
+ *
+ * @param format Text table or JSON Lines
+ */
+void Console::printSharingData(SnapshotFormat format) const {
+    MemorySharing sharing{ os.getMemorySharing() };
+
+    beginSnapshot(format, "\n\tM_START\tM_END\tREFS\n");
+
+    for (const auto & region : os.getSharedRegions()) {
+        if ( format == SnapshotFormat::Text ) {
+            cout << '\t' << region.first << '\t' << region.second.end << '\t'
+                 << region.second.references << '\n';
+        }
+        else {
+            cout << "{\"snapshot\":\"s\",\"m_start\":" << region.first
+                 << ",\"m_end\":" << region.second.end
+                 << ",\"refs\":" << region.second.references << "}\n";
+        }
+    }
+
+    if ( format == SnapshotFormat::Text ) {
+        cout << "\n\tPrivate bytes:\t\t" << sharing.private_bytes
+             << "\n\tShared bytes:\t\t" << sharing.shared_bytes
+             << "\n\tMapped bytes:\t\t" << sharing.mapped_bytes
+             << "\n\tSaved bytes:\t\t" << sharing.savedBytes()
+             << "\n\tForks:\t\t\t" << sharing.forks
+             << "\n\tCopy-on-write splits:\t" << sharing.copy_on_write_splits << '\n';
+    }
+    else {
+        cout << "{\"snapshot\":\"s\",\"private_bytes\":" << sharing.private_bytes
+             << ",\"shared_bytes\":" << sharing.shared_bytes
+             << ",\"mapped_bytes\":" << sharing.mapped_bytes
+             << ",\"saved_bytes\":" << sharing.savedBytes()
+             << ",\"forks\":" << sharing.forks
+             << ",\"copy_on_write_splits\":" << sharing.copy_on_write_splits << "}\n";
+    }
+
+    endSnapshot(format, "s", false, os.getSharedRegions().size() + 1);
+}
+
+/**
+ * Outputs the number of calls and the p50, p99, p99.9 and maximum
+ * wall-clock latency (in nanoseconds) of each timed OS operation.
+ * Latencies include any nested operation, e.g. every operation that
+ * changes the ready-queues also includes an updateCPU() call.
+ */
+void Console::printLatencyData(SnapshotFormat format) const {
+    const char * names[] { "create", "terminate", "next", "updateCPU", "toIO", "fromIO", "fork", "write" };
+
+    beginSnapshot(format, "\n\tOP\t\tCOUNT\tP50\tP99\tP999\tMAX\n");
+
+    for (size_t i{0}; i < static_cast<size_t>(LatencyOperation::Count); ++i) {
+        const LatencyHistogram & histogram{ os.getLatency( static_cast<LatencyOperation>(i) ) };
+
+        if ( format == SnapshotFormat::Text ) {
+            cout << '\t' << names[i] << ( string(names[i]).size() < 8 ? "\t\t" : "\t" )
+                 << histogram.count() << '\t'
+                 << histogram.valueAtPercentile(50.0) << '\t'
+                 << histogram.valueAtPercentile(99.0) << '\t'
+                 << histogram.valueAtPercentile(99.9) << '\t'
+                 << histogram.max() << '\n';
+        }
+        else {
+            cout << "{\"snapshot\":\"l\",\"op\":\"" << names[i] << '"'
+                 << ",\"count\":" << histogram.count()
+                 << ",\"p50\":" << histogram.valueAtPercentile(50.0)
+                 << ",\"p99\":" << histogram.valueAtPercentile(99.0)
+                 << ",\"p999\":" << histogram.valueAtPercentile(99.9)
+                 << ",\"max\":" << histogram.max() << "}\n";
+        }
+    }
+
+    endSnapshot(format, "l", false, static_cast<size_t>(LatencyOperation::Count));
+}
+
+/**
+ * Outputs every NUMA node's cores, address range and free memory, then
+ * the locality counters: dispatches on a process' home node (local) or
+ * elsewhere (remote), cross-node migrations, allocations that had to
+ * fall back to a remote node, and the resulting modelled throughput
+ * relative to perfect locality.
+ *
+ * @param format Text table or JSON Lines
+ */
+void Console::printNUMAData(SnapshotFormat format) const {
+    const RAM & memory{ os.getMemory() };
+    const NUMAStatistics & statistics{ os.getNUMAStatistics() };
+
+    beginSnapshot(format, "\n\tNODE\tCORES\tM_START\tM_END\tFREE\n");
+
+    for (uint node{0}; node < memory.getNodeCount(); ++node) {
+        const MemoryZone & zone{ memory.getZone(node) };
+        size_t cores{ 0 };
+
+        for (const CPU & processor : os.getCPUs()) {
+            cores += ( processor.getNode() == node );
+        }
+
+        if ( format == SnapshotFormat::Text ) {
+            cout << '\t' << node << '\t' << cores << '\t' << zone.getStart() << '\t'
+                 << zone.getEnd() << '\t' << zone.getFreeMemorySize() << '\n';
+        }
+        else {
+            cout << "{\"snapshot\":\"n\",\"node\":" << node << ",\"cores\":" << cores
+                 << ",\"m_start\":" << zone.getStart() << ",\"m_end\":" << zone.getEnd()
+                 << ",\"free\":" << zone.getFreeMemorySize() << "}\n";
+        }
+    }
+
+    if ( format == SnapshotFormat::Text ) {
+        cout << "\n\tLocal dispatches:\t" << statistics.local_dispatches
+             << "\n\tRemote dispatches:\t" << statistics.remote_dispatches
+             << "\n\tMigrations:\t\t" << statistics.migrations
+             << "\n\tLocal allocations:\t" << statistics.local_allocations
+             << "\n\tRemote allocations:\t" << statistics.remote_allocations
+             << "\n\tRelative throughput:\t" << statistics.relativeThroughput() * 100.0 << "%"
+             << " (remote cost x" << NUMA_REMOTE_PENALTY << ")\n";
+    }
+    else {
+        cout << "{\"snapshot\":\"n\",\"local_dispatches\":" << statistics.local_dispatches
+             << ",\"remote_dispatches\":" << statistics.remote_dispatches
+             << ",\"migrations\":" << statistics.migrations
+             << ",\"local_allocations\":" << statistics.local_allocations
+             << ",\"remote_allocations\":" << statistics.remote_allocations
+             << ",\"relative_throughput\":" << statistics.relativeThroughput() << "}\n";
+    }
+
+    endSnapshot(format, "n", false, memory.getNodeCount() + 1);
+}
+
+/**
+ * Outputs the allocation counters of the OS's internal memory pool:
+ * allocations and deallocations requested by its containers, and the
+ * allocations the pool itself made from the heap. Once the simulation
+ * reaches a steady state, requests keep growing while heap allocations
+ * stay flat.
+ *
+ * @param format Text table or JSON Lines
+ */
+void Console::printAllocationData(SnapshotFormat format) const {
+    AllocationStatistics statistics{ os.getAllocationStatistics() };
+
+    if ( format == SnapshotFormat::Text ) {
+        cout << "\n\tPool allocations:\t" << statistics.pool_allocations
+             << "\n\tPool deallocations:\t" << statistics.pool_deallocations
+             << "\n\tHeap allocations:\t" << statistics.heap_allocations
+             << "\n\tHeap deallocations:\t" << statistics.heap_deallocations
+             << "\n\tHeap bytes:\t\t" << statistics.heap_bytes
+             << "\n\tPeak heap bytes:\t" << statistics.peak_heap_bytes << '\n';
+    }
+    else {
+        cout << "{\"snapshot\":\"a\",\"pool_allocations\":" << statistics.pool_allocations
+             << ",\"pool_deallocations\":" << statistics.pool_deallocations
+             << ",\"heap_allocations\":" << statistics.heap_allocations
+             << ",\"heap_deallocations\":" << statistics.heap_deallocations
+             << ",\"heap_bytes\":" << statistics.heap_bytes
+             << ",\"peak_heap_bytes\":" << statistics.peak_heap_bytes << "}\n";
+    }
+
+    endSnapshot(format, "a", false, 1);
+}
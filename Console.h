@@ -0,0 +1,60 @@
+/// @author agent, from the console loop by Jonathan Kelaty
+/// @file CS OS Home Project - Console.h
+/// @date 2026-10-18
+/// @brief Console class declaration. Interactive front end of the
+/// simulated OS. Main driver is the run() member function, which
+/// accepts and sanitizes input, performs the requested operations
+/// through the OS API, and reports errors and snapshots on the console.
+/// Single commands can also be run from any stream with runCommand(),
+/// which is how the multi-producer ingest front end drives the OS.
+/// Snapshots can be full or delta (only processes changed since the
+/// previous snapshot of the same view), in text or JSON Lines form.
+
+#ifndef CONSOLE_H_
+#define CONSOLE_H_
+
+#include <istream>
+
+#include "DataTypes.h"
+#include "OS.h"
+
+// Output format of snapshots
+enum class SnapshotFormat { Text, JSON };
+
+/******************
+ * 
+ * Console Class
+ * 
+ ******************/
+
+class Console {
+
+    public:
+        Console() = delete;
+
+        Console(OS & simulator) :
+            os{ simulator } { /* Intentionally empty */ }
+
+        void run();
+        bool runCommand(std::istream & input, uint & core);
+
+        // Snapshots
+        void printCPUData(SnapshotFormat format, bool delta);
+        void printIOData(SnapshotFormat format, bool delta);
+        void printRAMData(SnapshotFormat format, bool delta);
+        void printSharingData(SnapshotFormat format) const;
+        void printLatencyData(SnapshotFormat format) const;
+        void printNUMAData(SnapshotFormat format) const;
+        void printAllocationData(SnapshotFormat format) const;
+
+    private:
+        OS & os;
+        uint current_core{ 0 };
+
+        void writeCPURecord(SnapshotFormat format, PID process_ID) const;
+        void writeIORecord(SnapshotFormat format, PID process_ID) const;
+        void writeRAMRecord(SnapshotFormat format, PID process_ID) const;
+
+};
+
+#endif // CONSOLE_H_
@@ -7,14 +7,23 @@
 #define DATA_TYPES_H_
 
 #include <deque>
+#include <memory_resource>
 #include <utility>
 
 enum class ProcessType { RealTime, Common, Invalid };
+enum class ProcessState { Ready, Running, IOWaiting, IOServing };
+
+// Result of an OS operation
+enum class Status {
+    Ok, InvalidSize, OutOfMemory, NoRunningProcess, NoReadyProcess,
+    InvalidHDD, InvalidCore, NoServedProcess, CheckpointWriteFailed, CheckpointReadFailed,
+    TraceOpenFailed, NoSuchProcess
+};
 
 typedef unsigned int uint;
 typedef unsigned int PID;
 
-typedef std::deque<PID> ReadyQueue;
+typedef std::pmr::deque<PID> ReadyQueue;
 typedef std::pair<uint, uint> MemoryBlock;
 
 #endif // DATA_TYPES_H_
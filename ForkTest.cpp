@@ -0,0 +1,155 @@
+/// @author agent
+/// @file CS OS Home Project - ForkTest.cpp
+/// @date 2026-10-18
+/// @brief Checks copy-on-write memory sharing between forked processes.
+/// A shared block must only be freed once the last process using it
+/// terminates, and RAM delta snapshots must report a terminated process
+/// as "Released" while its block is still shared and as "Freed" once
+/// it is not. Run with "make test".
+
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include "DataTypes.h"
+#include "OS.h"
+#include "Console.h"
+
+/**
+ * @param os OS to check
+ *
+ * @return Bytes of RAM not used by any process
+ */
+unsigned long long freeBytes(const OS & os) {
+    unsigned long long free_bytes{ 0 };
+
+    for (uint node{0}; node < os.getMemory().getNodeCount(); ++node) {
+        for (const MemoryBlock & free_memory : os.getMemory().getZone(node).getAvailableMemory()) {
+            free_bytes += free_memory.second - free_memory.first + 1;
+        }
+    }
+
+    return free_bytes;
+}
+
+/**
+ * Terminates the process running on core 0 and checks how much RAM is
+ * free afterwards.
+ *
+ * @param os OS to terminate the process in
+ * @param process_ID Process expected to be running
+ * @param expected_free Bytes expected to be free after terminating it
+ *
+ * @return Empty string if the process was terminated as expected, else
+ * the problem
+ */
+std::string terminate(OS & os, PID process_ID, unsigned long long expected_free) {
+    if ( os.getCPUs()[0].currentProcessPID() != process_ID ) {
+        return "PID " + std::to_string(process_ID) + " is not running";
+    }
+
+    os.terminateCurrentProcess();
+
+    if ( freeBytes(os) != expected_free ) {
+        return "after terminating PID " + std::to_string(process_ID) + " " +
+            std::to_string(freeBytes(os)) + " bytes are free, expected " + std::to_string(expected_free);
+    }
+
+    return "";
+}
+
+/**
+ * RAM of 30. PID 1 gets [0,9], and PIDs 2 and 3 are forked from it. PID 2
+ * writes and gets a private copy, leaving [0,9] shared by PIDs 1 and 3.
+ * Terminating PID 1 keeps the block, terminating PID 2 frees its copy,
+ * and terminating PID 3 frees the shared block (once).
+ *
+ * @return Empty string if memory is shared and freed as expected, else
+ * the problem
+ */
+std::string testCopyOnWrite() {
+    OS os(30, 0);
+
+    os.createNewProcess(ProcessType::Common, 10);
+    os.forkProcess(1);
+    os.forkProcess(1);
+
+    if ( os.getSharedRegions().size() != 1 || os.getSharedRegions().at(0).references != 3 ) {
+        return "fork did not share the block with 3 processes";
+    }
+
+    if ( os.writeProcessMemory(2) != Status::Ok || freeBytes(os) != 10 ||
+         os.getSharedRegions().at(0).references != 2 ) {
+        return "write did not give PID 2 a private copy";
+    }
+
+    std::string problem{ terminate(os, 1, 10) };
+
+    if ( problem.empty() && ( ! os.getSharedRegions().empty() || ! os.isMemoryBlockKept(1) ) ) {
+        problem = "block of PID 1 was not kept for PID 3";
+    }
+
+    if ( problem.empty() ) {
+        problem = terminate(os, 2, 20);
+    }
+
+    if ( problem.empty() ) {
+        problem = terminate(os, 3, 30);
+    }
+
+    if ( problem.empty() && ( os.isMemoryBlockKept(2) || os.isMemoryBlockKept(3) ) ) {
+        problem = "freed block reported as kept";
+    }
+
+    return problem;
+}
+
+/**
+ * Forks PID 1 and terminates it, then PID 2, taking a RAM delta snapshot
+ * after each one.
+ *
+ * @return Empty string if the snapshots are as expected, else the problem
+ */
+std::string testDeltaSnapshot() {
+    OS os(30, 0);
+    Console console(os);
+    std::istringstream input{ "A 10\nF 1\nS dm\nt\nS dm\nt\nS dm\n" };
+    std::ostringstream output;
+    std::streambuf * console_output{ std::cout.rdbuf( output.rdbuf() ) };
+    uint core{ 0 };
+
+    while ( console.runCommand(input, core) ) { /* Run every command */ }
+
+    std::cout.rdbuf( console_output );
+
+    const std::string header{ "\n\tPID\tM_START\tM_END\n" };
+    size_t released{ output.str().find(header + "\t1\t-\t-\tReleased\n\n") };
+    size_t freed{ output.str().find(header + "\t2\t-\t-\tFreed\n\n") };
+
+    if ( released == std::string::npos || freed == std::string::npos || freed < released ) {
+        return "unexpected snapshots:" + output.str();
+    }
+
+    return "";
+}
+
+int main() {
+    std::string problem{ testCopyOnWrite() };
+
+    if ( ! problem.empty() ) {
+        std::cout << "FAIL fork copy-on-write, " << problem << std::endl;
+        return 1;
+    }
+
+    std::cout << "PASS fork copy-on-write" << std::endl;
+
+    problem = testDeltaSnapshot();
+
+    if ( ! problem.empty() ) {
+        std::cout << "FAIL fork RAM delta, " << problem << std::endl;
+        return 1;
+    }
+
+    std::cout << "PASS fork RAM delta" << std::endl;
+    return 0;
+}
@@ -4,12 +4,14 @@
 /// @brief HDD class implementation. Manages its IO-queue, which is
 /// implemented as first come, first served (FCFS). The next process
 /// is served (if available) whenever a process is finished being
-/// served. Enumeration of HDD number is managed by OS class.
+/// served. Enumeration of HDD number is managed by OS class. The
+/// IO-queue allocates from the memory resource it is given.
 
 #ifndef HDD_H_
 #define HDD_H_
 
 #include "DataTypes.h"
+#include "Checkpoint.h"
 
 /******************************
  * 
@@ -20,6 +22,9 @@
 class HDD {
 
     public:
+        HDD(std::pmr::memory_resource * resource = std::pmr::get_default_resource()) :
+            IO_queue{ resource } { /* Intentionally empty */ }
+
         bool isServing() const {
             return current_process;
         }
@@ -51,6 +56,27 @@ class HDD {
             return IO_queue;
         }
 
+        void saveState(CheckpointWriter & writer) const {
+            writer.write( current_process );
+            writer.write( IO_queue );
+        }
+
+        /**
+         * Restores the HDD from a checkpoint image. A drive with waiting
+         * processes must be serving one, since updateIOQueue() never
+         * leaves the drive idle while its IO-queue is non-empty.
+         *
+         * @param reader Checkpoint image positioned at this HDD's state
+         *
+         * @return False if the image is truncated or inconsistent, else true
+         */
+        bool loadState(CheckpointReader & reader) {
+            reader.read( current_process );
+            reader.read( IO_queue );
+
+            return reader.good() && ( isServing() || IO_queue.empty() );
+        }
+
     private:
         PID current_process{ 0 };
         ReadyQueue IO_queue;
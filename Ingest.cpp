@@ -0,0 +1,345 @@
+/// @author agent
+/// @file CS OS Home Project - Ingest.cpp
+/// @date 2026-10-18
+/// @brief IngestServer class implementation. Implementation details
+/// can be found in function documentation below.
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <thread>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "DataTypes.h"
+#include "Ingest.h"
+
+using std::cout;
+using std::string;
+
+// Tick of the empty command a producer pushes last, when it disconnects
+const std::uint64_t CLOSED_WATERMARK{ std::numeric_limits<std::uint64_t>::max() };
+
+// Highest tick a line can have, so ticks never reach CLOSED_WATERMARK
+const std::uint64_t MAX_TICK{ CLOSED_WATERMARK - 2 };
+
+IngestServer::IngestServer(Console & front_end, uint producer_count) :
+    console{ front_end }, producers( producer_count ) { /* Intentionally empty */ }
+
+/**
+ * Listens on a Unix domain socket until the expected number of producers
+ * have connected, then runs their commands until all of them have
+ * disconnected. This (calling) thread is the simulation thread: it is the
+ * only one that touches the Console and OS.
+ *
+ * Every command has a tick, which is the producer's previous tick + 1
+ * unless the line starts with "@<tick>" (a line holding only "@<tick>"
+ * just advances the producer's clock). Commands are run in order of
+ * (tick, producer), where producers are numbered in connection order. A
+ * command only runs once a command with the same or a later tick has
+ * been popped from every producer (each producer's commands leave the
+ * queue in order), so the order does not depend on thread timing, but an
+ * idle producer holds back the others.
+ *
+ * @param socket_path Path of socket to create (replaced if it exists)
+ *
+ * @return False if the socket could not be created, else true
+ */
+bool IngestServer::run(const string & socket_path) {
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+
+    if ( socket_path.empty() || socket_path.size() >= sizeof(address.sun_path) ) {
+        return false;
+    }
+
+    std::memcpy(address.sun_path, socket_path.c_str(), socket_path.size() + 1);
+
+    int listen_socket{ ::socket(AF_UNIX, SOCK_STREAM, 0) };
+
+    if ( listen_socket < 0 ) {
+        return false;
+    }
+
+    ::unlink( socket_path.c_str() );
+
+    if ( ::bind(listen_socket, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0
+            || ::listen(listen_socket, static_cast<int>(producers.size())) != 0 ) {
+        ::close(listen_socket);
+        return false;
+    }
+
+    std::thread acceptor{ &IngestServer::acceptProducers, this, listen_socket };
+    auto last_command{ std::chrono::steady_clock::now() };
+
+    while ( true ) {
+        size_t drained{ drainBatch() };
+        std::uint64_t low_watermark{ lowWatermark() };
+        size_t applied{ applyReady(low_watermark) };
+
+        if ( applied ) {
+            last_command = std::chrono::steady_clock::now();
+        }
+
+        if ( low_watermark == CLOSED_WATERMARK && held.empty() ) {
+            break;
+        }
+
+        if ( ! drained && ! applied ) {
+            std::this_thread::sleep_for( std::chrono::microseconds(100) );
+        }
+    }
+
+    acceptor.join();
+    ::unlink( socket_path.c_str() );
+
+    statistics.rejected = rejected.load();
+    statistics.full_queue_retries = full_queue_retries.load();
+
+    if ( statistics.commands ) {
+        statistics.seconds = std::chrono::duration<double>(last_command - first_command).count();
+    }
+
+    return true;
+}
+
+/**
+ * Outputs the ingest counters: commands run, how many batches they were
+ * drained in, lines rejected (too long or with an invalid tick), the
+ * ingest rate from the first command drained to the last one run, and
+ * the backpressure seen by producers (pushes retried because the queue
+ * was full, and the deepest the queue and the reorder buffer got).
+ */
+void IngestServer::printStatistics() const {
+    cout << "\n\tProducers:\t\t" << producers.size()
+         << "\n\tCommands:\t\t" << statistics.commands
+         << "\n\tBatches:\t\t" << statistics.batches
+         << "\n\tRejected:\t\t" << statistics.rejected
+         << "\n\tIngest rate:\t\t" << statistics.commandsPerSecond() << " commands/s"
+         << "\n\tFull-queue retries:\t" << statistics.full_queue_retries
+         << "\n\tMax queue depth:\t" << statistics.max_queue_depth << " / " << queue.capacity()
+         << "\n\tMax held for order:\t" << statistics.max_held << '\n' << std::endl;
+}
+
+/**
+ * Accepts one connection per producer and starts a reader thread for
+ * each. Producers that can never connect (accept failed) are closed
+ * right away so the simulation thread does not wait for them.
+ *
+ * @param listen_socket Socket producers connect to
+ */
+void IngestServer::acceptProducers(int listen_socket) {
+    vector<std::thread> readers;
+
+    for (uint producer{0}; producer < producers.size(); ++producer) {
+        int producer_socket{ ::accept(listen_socket, nullptr, nullptr) };
+
+        if ( producer_socket < 0 ) {
+            for (uint i{producer}; i < producers.size(); ++i) {
+                push(i, CLOSED_WATERMARK, "", 0);
+            }
+            break;
+        }
+
+        readers.emplace_back( &IngestServer::readProducer, this, producer, producer_socket );
+    }
+
+    ::close(listen_socket);
+
+    for (std::thread & reader : readers) {
+        reader.join();
+    }
+}
+
+/**
+ * Splits a producer's stream into lines and submits them until the
+ * producer disconnects.
+ *
+ * @param producer Producer number
+ * @param producer_socket Connection of producer
+ */
+void IngestServer::readProducer(uint producer, int producer_socket) {
+    char buffer[4096];
+    string line{ "" };
+    std::uint64_t tick{ 0 };
+    ssize_t received{ 0 };
+
+    while ( (received = ::read(producer_socket, buffer, sizeof(buffer))) > 0 ) {
+        for (ssize_t i{0}; i < received; ++i) {
+            if ( buffer[i] == '\n' ) {
+                submit(producer, line, tick);
+                line.clear();
+            }
+            else {
+                line += buffer[i];
+            }
+        }
+    }
+
+    if ( ! line.empty() ) {
+        submit(producer, line, tick);
+    }
+
+    ::close(producer_socket);
+    push(producer, CLOSED_WATERMARK, "", 0);
+}
+
+/**
+ * Stamps a line with its tick and pushes it to the command queue. A line
+ * with only "@<tick>" is pushed as an empty command, which runs nothing
+ * but tells the simulation thread the producer has reached that tick.
+ * Requested ticks that are not after the producer's previous tick are
+ * moved up to keep ticks strictly increasing. A line whose tick is not a
+ * plain number, or would be past MAX_TICK, is rejected and leaves the
+ * producer's tick unchanged.
+ *
+ * @param producer Producer number
+ * @param line Line read from producer
+ * @param tick Producer's tick, advanced to the tick of this line
+ */
+void IngestServer::submit(uint producer, const string & line, std::uint64_t & tick) {
+    size_t begin{ line.find_first_not_of(" \t\r") };
+
+    if ( begin == string::npos ) {
+        return;
+    }
+
+    std::uint64_t next_tick{ tick + 1 };
+
+    if ( line[begin] == '@' ) {
+        const char * number{ line.c_str() + begin + 1 };
+        char * end{ nullptr };
+
+        // strtoull would accept a sign (wrapping negative numbers) and
+        // leading spaces, so the tick must start with a digit
+        errno = 0;
+        std::uint64_t requested{ std::isdigit(static_cast<unsigned char>(*number))
+            ? std::strtoull(number, &end, 10) : 0 };
+
+        if ( ! end || errno == ERANGE || ! (*end == '\0' || std::isspace(static_cast<unsigned char>(*end))) ) {
+            rejected.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        next_tick = std::max(next_tick, requested);
+        begin = std::min( line.find_first_not_of(" \t\r", end - line.c_str()), line.size() );
+    }
+
+    if ( next_tick > MAX_TICK ) {
+        rejected.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    tick = next_tick;
+
+    size_t length{ line.size() - begin };
+
+    if ( length >= COMMAND_TEXT_SIZE ) {
+        rejected.fetch_add(1, std::memory_order_relaxed);
+        length = 0;
+    }
+
+    push(producer, tick, line.c_str() + begin, length);
+}
+
+/**
+ * Pushes a command to the command queue, retrying while it is full.
+ *
+ * @param producer Producer number
+ * @param tick Tick of command
+ * @param text Command text (not null terminated)
+ * @param length Length of text, 0 for an empty command
+ */
+void IngestServer::push(uint producer, std::uint64_t tick, const char * text, size_t length) {
+    Command command;
+    command.tick = tick;
+    command.producer = producer;
+    std::memcpy(command.text, text, length);
+    command.text[length] = '\0';
+
+    while ( ! queue.tryPush(command) ) {
+        full_queue_retries.fetch_add(1, std::memory_order_relaxed);
+        std::this_thread::yield();
+    }
+}
+
+/**
+ * @return Lowest tick popped from any producer, or CLOSED_WATERMARK once
+ * the last command of every producer has been popped
+ */
+std::uint64_t IngestServer::lowWatermark() const {
+    std::uint64_t low_watermark{ CLOSED_WATERMARK };
+
+    for (const Producer & producer : producers) {
+        low_watermark = std::min( low_watermark, producer.popped_tick );
+    }
+
+    return low_watermark;
+}
+
+/**
+ * Moves up to a batch of commands from the queue into the reorder heap,
+ * advancing each producer's popped tick. Empty commands only advance the
+ * tick.
+ *
+ * @return Number of commands drained
+ */
+size_t IngestServer::drainBatch() {
+    statistics.max_queue_depth = std::max( statistics.max_queue_depth, queue.size() );
+
+    Command command;
+    size_t drained{ 0 };
+
+    while ( drained < INGEST_BATCH_SIZE && queue.tryPop(command) ) {
+        producers[command.producer].popped_tick = command.tick;
+
+        if ( command.text[0] ) {
+            held.push( command );
+        }
+
+        ++drained;
+    }
+
+    if ( drained ) {
+        if ( ! statistics.batches ) {
+            first_command = std::chrono::steady_clock::now();
+        }
+
+        ++statistics.batches;
+        statistics.max_held = std::max( statistics.max_held, held.size() );
+    }
+
+    return drained;
+}
+
+/**
+ * Runs held commands in (tick, producer) order up to the low watermark.
+ * Each producer has its own selected core.
+ *
+ * @param low_watermark Highest tick that is safe to run
+ *
+ * @return Number of commands run
+ */
+size_t IngestServer::applyReady(std::uint64_t low_watermark) {
+    size_t applied{ 0 };
+
+    while ( ! held.empty() && held.top().tick <= low_watermark ) {
+        std::istringstream input{ held.top().text };
+        uint & core{ producers[held.top().producer].core };
+
+        while ( console.runCommand(input, core) ) { /* Run every command on the line */ }
+
+        held.pop();
+        ++applied;
+    }
+
+    statistics.commands += applied;
+    return applied;
+}
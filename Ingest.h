@@ -0,0 +1,107 @@
+/// @author agent
+/// @file CS OS Home Project - Ingest.h
+/// @date 2026-10-18
+/// @brief IngestServer class declaration. Front end that lets several
+/// local producers (e.g. one load generator per tenant) drive the
+/// simulated OS at once. Each producer connects to a Unix domain socket
+/// and writes console commands, one per line. Reader threads push them
+/// into a lock-free CommandQueue, and the simulation thread drains it in
+/// batches and runs them through the Console in tick order, so the same
+/// inputs always produce the same simulation regardless of how threads
+/// are scheduled.
+
+#ifndef INGEST_H_
+#define INGEST_H_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <queue>
+#include <string>
+#include <vector>
+
+#include "DataTypes.h"
+#include "CommandQueue.h"
+#include "Console.h"
+
+// Capacity of the command queue shared by all producers
+const size_t INGEST_QUEUE_CAPACITY{ 4096 };
+
+// Most commands taken from the queue before applying ready ones
+const size_t INGEST_BATCH_SIZE{ 256 };
+
+// Ingest counters, reported once every producer has disconnected
+struct IngestStatistics {
+    unsigned long long commands{ 0 };
+    unsigned long long batches{ 0 };
+    unsigned long long rejected{ 0 };
+    unsigned long long full_queue_retries{ 0 };
+    size_t max_queue_depth{ 0 };
+    size_t max_held{ 0 };
+    double seconds{ 0.0 };
+
+    double commandsPerSecond() const {
+        return seconds > 0.0 ? commands / seconds : 0.0;
+    }
+};
+
+/***********************
+ *
+ * Ingest Server Class
+ *
+ ***********************/
+
+class IngestServer {
+
+    public:
+        IngestServer() = delete;
+        IngestServer(const IngestServer &) = delete;
+        IngestServer & operator=(const IngestServer &) = delete;
+
+        IngestServer(Console & front_end, uint producer_count);
+
+        bool run(const std::string & socket_path);
+        void printStatistics() const;
+
+        const IngestStatistics & getStatistics() const {
+            return statistics;
+        }
+
+    private:
+        // State of one producer, only used by the simulation thread.
+        // A producer's commands are popped in push order with increasing
+        // ticks, so every command up to popped_tick has been popped
+        struct Producer {
+            std::uint64_t popped_tick{ 0 };
+            uint core{ 0 };
+        };
+
+        // Orders the held commands' heap so the lowest tick is on top
+        struct LaterCommand {
+            bool operator()(const Command & a, const Command & b) const {
+                return a.tick != b.tick ? a.tick > b.tick : a.producer > b.producer;
+            }
+        };
+
+        void acceptProducers(int listen_socket);
+        void readProducer(uint producer, int producer_socket);
+        void submit(uint producer, const std::string & line, std::uint64_t & tick);
+        void push(uint producer, std::uint64_t tick, const char * text, size_t length);
+
+        std::uint64_t lowWatermark() const;
+        size_t drainBatch();
+        size_t applyReady(std::uint64_t low_watermark);
+
+        Console & console;
+        CommandQueue queue{ INGEST_QUEUE_CAPACITY };
+        std::vector<Producer> producers;
+        std::priority_queue<Command, std::vector<Command>, LaterCommand> held;
+
+        std::atomic<unsigned long long> rejected{ 0 };
+        std::atomic<unsigned long long> full_queue_retries{ 0 };
+        std::chrono::steady_clock::time_point first_command;
+        IngestStatistics statistics;
+
+};
+
+#endif // INGEST_H_
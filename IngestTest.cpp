@@ -0,0 +1,236 @@
+/// @author agent
+/// @file CS OS Home Project - IngestTest.cpp
+/// @date 2026-10-18
+/// @brief Checks that the ingest front end runs commands from several
+/// producers in tick order. Producer 0 creates size 1 processes and
+/// then asks for a RAM snapshot far in the future, producer 1 creates
+/// size 2 processes. Ticks interleave the two, so every run must give
+/// the same PIDs and memory layout, and the snapshot must only run once
+/// every process exists. Also checks that requested ticks which would
+/// wrap around are rejected. Run with "make test".
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "DataTypes.h"
+#include "OS.h"
+#include "Console.h"
+#include "Ingest.h"
+
+const char * const SOCKET_PATH{ "ingest_test.sock" };
+const uint PROCESSES_PER_PRODUCER{ 3000 };
+const int RUNS{ 5 };
+
+/**
+ * Connects to the ingest socket (retrying until the server listens) and
+ * writes the producer's commands, in chunks with pauses in between so
+ * the two producers interleave differently from run to run. Producers
+ * are numbered in connection order, so a producer waits for the previous
+ * one to connect (or to finish) before connecting.
+ *
+ * @param commands Newline separated commands to send
+ * @param chunk_size Bytes written at a time
+ * @param start Set once this producer may connect
+ * @param connected Set once this producer has connected
+ * @param done Set once this producer has sent everything and closed
+ */
+void produce(const std::string & commands, size_t chunk_size, const std::atomic<bool> & start,
+             std::atomic<bool> & connected, std::atomic<bool> & done) {
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    std::string(SOCKET_PATH).copy(address.sun_path, sizeof(address.sun_path) - 1);
+
+    int producer_socket{ ::socket(AF_UNIX, SOCK_STREAM, 0) };
+
+    while ( ! start.load() ) {
+        std::this_thread::yield();
+    }
+
+    while ( ::connect(producer_socket, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0 ) {
+        std::this_thread::sleep_for( std::chrono::milliseconds(1) );
+    }
+
+    connected.store(true);
+
+    for (size_t sent{0}; sent < commands.size(); sent += chunk_size) {
+        size_t length{ std::min(chunk_size, commands.size() - sent) };
+
+        if ( ::write(producer_socket, commands.data() + sent, length) != static_cast<ssize_t>(length) ) {
+            break;
+        }
+
+        std::this_thread::yield();
+    }
+
+    ::close(producer_socket);
+    done.store(true);
+}
+
+/**
+ * Checks a RAM snapshot against the only valid order: at tick t,
+ * producer 0's size 1 process, then producer 1's size 2 process.
+ *
+ * @param output Console output of the run
+ *
+ * @return Empty string if the snapshot is as expected, else the problem
+ */
+std::string checkSnapshot(const std::string & output) {
+    std::istringstream lines{ output };
+    std::string line{ "" };
+    uint rows{ 0 };
+
+    while ( std::getline(lines, line) && line.find("M_START") == std::string::npos ) {
+        /* Skip to snapshot header */
+    }
+
+    while ( std::getline(lines, line) && ! line.empty() ) {
+        std::istringstream row{ line };
+        uint process_ID{ 0 };
+        uint start{ 0 };
+        uint end{ 0 };
+
+        row >> process_ID >> start >> end;
+        ++rows;
+
+        uint pair_start{ (process_ID - 1) / 2 * 3 };
+        uint expected_start{ process_ID % 2 ? pair_start : pair_start + 1 };
+        uint expected_end{ process_ID % 2 ? expected_start : expected_start + 1 };
+
+        if ( process_ID != rows || start != expected_start || end != expected_end ) {
+            return "unexpected row: " + line;
+        }
+    }
+
+    if ( rows != 2 * PROCESSES_PER_PRODUCER ) {
+        return "snapshot has " + std::to_string(rows) + " processes";
+    }
+
+    return "";
+}
+
+/**
+ * Runs two producers with interleaved ticks, varying how their streams
+ * interleave, and checks every run gives the same snapshot.
+ *
+ * @return Empty string if every run is as expected, else the problem
+ */
+std::string testTickOrder() {
+    std::string commands[2];
+
+    for (uint i{0}; i < PROCESSES_PER_PRODUCER; ++i) {
+        commands[0] += "A 1\n";
+        commands[1] += "A 2\n";
+    }
+
+    commands[0] += "@100000 S m\n";
+
+    for (int run{0}; run < RUNS; ++run) {
+        OS os(3 * PROCESSES_PER_PRODUCER, 0);
+        Console console(os);
+        IngestServer server(console, 2);
+
+        std::ostringstream output;
+        std::streambuf * console_output{ std::cout.rdbuf( output.rdbuf() ) };
+
+        std::atomic<bool> start{ true };
+        std::atomic<bool> connected[2]{ { false }, { false } };
+        std::atomic<bool> done[2]{ { false }, { false } };
+
+        // Vary chunk sizes so each run sees a different interleaving. In
+        // even runs producer 1 only connects once producer 0 is done, so
+        // its whole stream arrives while producer 0's commands wait
+        std::thread producer0{ produce, std::cref(commands[0]), static_cast<size_t>(64 << run),
+                               std::cref(start), std::ref(connected[0]), std::ref(done[0]) };
+        std::thread producer1{ produce, std::cref(commands[1]), static_cast<size_t>(4096 >> run),
+                               std::cref(run % 2 ? connected[0] : done[0]),
+                               std::ref(connected[1]), std::ref(done[1]) };
+
+        bool listening{ server.run(SOCKET_PATH) };
+
+        producer0.join();
+        producer1.join();
+        std::cout.rdbuf( console_output );
+
+        std::string problem{ listening ? checkSnapshot( output.str() ) : "could not listen" };
+
+        if ( ! problem.empty() ) {
+            return "run " + std::to_string(run) + ": " + problem;
+        }
+    }
+
+    return "";
+}
+
+/**
+ * Sends lines whose requested tick is past the last usable tick, negative
+ * or not a number. They must be rejected without moving the producer's
+ * tick, so the later "A 1" still runs after "A 5".
+ *
+ * @return Empty string if the run is as expected, else the problem
+ */
+std::string testTickBounds() {
+    std::string commands{ "A 5\n@18446744073709551615\n@18446744073709551614 A 2\n"
+                          "@-1 A 3\n@ 7 A 3\n@12x A 3\nA 1\nS m\n" };
+
+    OS os(10, 0);
+    Console console(os);
+    IngestServer server(console, 1);
+
+    std::ostringstream output;
+    std::streambuf * console_output{ std::cout.rdbuf( output.rdbuf() ) };
+
+    std::atomic<bool> start{ true };
+    std::atomic<bool> connected{ false };
+    std::atomic<bool> done{ false };
+    std::thread producer{ produce, std::cref(commands), commands.size(),
+                          std::cref(start), std::ref(connected), std::ref(done) };
+
+    bool listening{ server.run(SOCKET_PATH) };
+
+    producer.join();
+    std::cout.rdbuf( console_output );
+
+    if ( ! listening ) {
+        return "could not listen";
+    }
+
+    if ( output.str().find("\tPID\tM_START\tM_END\n\t1\t0\t4\n\t2\t5\t5\n\n") == std::string::npos ) {
+        return "unexpected snapshot:" + output.str();
+    }
+
+    if ( server.getStatistics().rejected != 5 ) {
+        return std::to_string(server.getStatistics().rejected) + " lines rejected, expected 5";
+    }
+
+    return "";
+}
+
+int main() {
+    std::string problem{ testTickOrder() };
+
+    if ( ! problem.empty() ) {
+        std::cout << "FAIL ingest tick order, " << problem << std::endl;
+        return 1;
+    }
+
+    std::cout << "PASS ingest tick order (" << RUNS << " runs)" << std::endl;
+
+    problem = testTickBounds();
+
+    if ( ! problem.empty() ) {
+        std::cout << "FAIL ingest tick bounds, " << problem << std::endl;
+        return 1;
+    }
+
+    std::cout << "PASS ingest tick bounds" << std::endl;
+    return 0;
+}
@@ -0,0 +1,145 @@
+/// @author agent
+/// @file CS OS Home Project - LatencyHistogram.h
+/// @date 2026-10-18
+/// @brief LatencyHistogram class implementation. Records wall-clock
+/// latencies (in nanoseconds) of simulator operations into log-bucketed
+/// counters, in the style of an HDR histogram: every power of two is
+/// split into 16 linear sub-buckets, so recorded values keep roughly 6%
+/// relative precision while recording stays a few instructions and the
+/// histogram never allocates.
+
+#ifndef LATENCY_HISTOGRAM_H_
+#define LATENCY_HISTOGRAM_H_
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+
+#include "DataTypes.h"
+
+/********************************
+ *
+ * Latency Histogram Class
+ *
+ ********************************/
+
+class LatencyHistogram {
+
+    public:
+        void record(std::uint64_t value) {
+            ++buckets[bucketIndex( value )];
+            ++total_count;
+
+            if ( value > max_value ) {
+                max_value = value;
+            }
+        }
+
+        std::uint64_t count() const {
+            return total_count;
+        }
+
+        std::uint64_t max() const {
+            return max_value;
+        }
+
+        /**
+         * Finds the value at a given percentile. Values are reported as the
+         * highest value of the bucket they fall into (capped at the largest
+         * recorded value), so percentiles never under-report latency.
+         *
+         * @param percentile Percentile to find, in the range (0, 100]
+         *
+         * @return Value at the percentile, or 0 if nothing was recorded
+         */
+        std::uint64_t valueAtPercentile(double percentile) const {
+            if ( ! total_count ) {
+                return 0;
+            }
+
+            std::uint64_t target( percentile / 100.0 * total_count + 0.5 );
+            std::uint64_t seen{ 0 };
+
+            if ( ! target ) {
+                target = 1;
+            }
+
+            for (size_t i{0}; i < BUCKET_COUNT; ++i) {
+                seen += buckets[i];
+
+                if ( seen >= target ) {
+                    std::uint64_t value{ bucketUpperBound( i ) };
+                    return value < max_value ? value : max_value;
+                }
+            }
+
+            return max_value;
+        }
+
+    private:
+        static const uint SUB_BUCKET_BITS{ 4 };
+        static const uint SUB_BUCKETS{ 1 << SUB_BUCKET_BITS };
+        static const size_t BUCKET_COUNT{ SUB_BUCKETS + (64 - SUB_BUCKET_BITS) * SUB_BUCKETS };
+
+        /*
+         * Values below 16 get a bucket each. Larger values are bucketed by
+         * their highest set bit (exponent) and the next 4 bits below it.
+         */
+        static size_t bucketIndex(std::uint64_t value) {
+            if ( value < SUB_BUCKETS ) {
+                return value;
+            }
+
+            uint exponent( 63 - __builtin_clzll( value ) );
+            uint shift{ exponent - SUB_BUCKET_BITS };
+            size_t sub_bucket( (value >> shift) - SUB_BUCKETS );
+
+            return SUB_BUCKETS + shift * SUB_BUCKETS + sub_bucket;
+        }
+
+        static std::uint64_t bucketUpperBound(size_t index) {
+            if ( index < SUB_BUCKETS ) {
+                return index;
+            }
+
+            uint shift( (index - SUB_BUCKETS) / SUB_BUCKETS );
+            std::uint64_t sub_bucket( (index - SUB_BUCKETS) % SUB_BUCKETS );
+            std::uint64_t lower{ (SUB_BUCKETS + sub_bucket) << shift };
+
+            return lower + (std::uint64_t{1} << shift) - 1;
+        }
+
+        std::array<std::uint64_t, BUCKET_COUNT> buckets{};
+        std::uint64_t total_count{ 0 };
+        std::uint64_t max_value{ 0 };
+
+};
+
+/*
+ * Records the wall-clock time between its construction and destruction
+ * into a latency histogram. Used to time a whole OS operation by placing
+ * one at the top of the function.
+ */
+class ScopedLatencyTimer {
+
+    public:
+        ScopedLatencyTimer() = delete;
+        ScopedLatencyTimer(const ScopedLatencyTimer &) = delete;
+        ScopedLatencyTimer & operator=(const ScopedLatencyTimer &) = delete;
+
+        ScopedLatencyTimer(LatencyHistogram & target) :
+            histogram{ target },
+            start_time{ std::chrono::steady_clock::now() } { /* Intentionally empty */ }
+
+        ~ScopedLatencyTimer() {
+            auto elapsed{ std::chrono::steady_clock::now() - start_time };
+            histogram.record( std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count() );
+        }
+
+    private:
+        LatencyHistogram & histogram;
+        std::chrono::steady_clock::time_point start_time;
+
+};
+
+#endif // LATENCY_HISTOGRAM_H_
@@ -0,0 +1,134 @@
+/// @author agent
+/// @file CS OS Home Project - MemoryPool.h
+/// @date 2026-10-18
+/// @brief MemoryPool class implementation. Pooled memory for the OS's
+/// internal containers (free memory blocks, process table, ready- and
+/// IO-queues, delta snapshot lists). Nodes are carved from slabs of
+/// fixed-size blocks by a std::pmr pool resource, and freed nodes are
+/// kept for reuse instead of being returned to the heap, so once the
+/// simulation reaches a steady state its containers stop calling malloc
+/// and free. Requests to the pool and allocations the pool makes from
+/// the heap are both counted.
+
+#ifndef MEMORY_POOL_H_
+#define MEMORY_POOL_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <memory_resource>
+
+#include "DataTypes.h"
+
+// Allocation counters of a MemoryPool
+struct AllocationStatistics {
+    unsigned long long pool_allocations{ 0 };
+    unsigned long long pool_deallocations{ 0 };
+    unsigned long long heap_allocations{ 0 };
+    unsigned long long heap_deallocations{ 0 };
+    size_t heap_bytes{ 0 };
+    size_t peak_heap_bytes{ 0 };
+};
+
+/***************************
+ *
+ * Counting Resource Class
+ *
+ ***************************/
+
+class CountingResource : public std::pmr::memory_resource {
+
+    public:
+        CountingResource() = delete;
+
+        CountingResource(std::pmr::memory_resource * upstream_resource) :
+            upstream{ upstream_resource } { /* Intentionally empty */ }
+
+        unsigned long long allocations() const {
+            return allocation_count;
+        }
+
+        unsigned long long deallocations() const {
+            return deallocation_count;
+        }
+
+        size_t bytesInUse() const {
+            return bytes_in_use;
+        }
+
+        size_t peakBytes() const {
+            return peak_bytes;
+        }
+
+    private:
+        void * do_allocate(size_t bytes, size_t alignment) override {
+            void * memory{ upstream->allocate(bytes, alignment) };
+
+            ++allocation_count;
+            bytes_in_use += bytes;
+            peak_bytes = std::max(peak_bytes, bytes_in_use);
+
+            return memory;
+        }
+
+        void do_deallocate(void * memory, size_t bytes, size_t alignment) override {
+            upstream->deallocate(memory, bytes, alignment);
+
+            ++deallocation_count;
+            bytes_in_use -= bytes;
+        }
+
+        bool do_is_equal(const std::pmr::memory_resource & other) const noexcept override {
+            return this == &other;
+        }
+
+        std::pmr::memory_resource * upstream;
+        unsigned long long allocation_count{ 0 };
+        unsigned long long deallocation_count{ 0 };
+        size_t bytes_in_use{ 0 };
+        size_t peak_bytes{ 0 };
+
+};
+
+/**********************
+ *
+ * Memory Pool Class
+ *
+ **********************/
+
+class MemoryPool {
+
+    public:
+        MemoryPool() = default;
+        MemoryPool(const MemoryPool &) = delete;
+        MemoryPool & operator=(const MemoryPool &) = delete;
+
+        /*
+         * Resource containers allocate from. Not thread-safe: a pool must
+         * only be used by the thread running its OS.
+         */
+        std::pmr::memory_resource * resource() {
+            return &requests;
+        }
+
+        AllocationStatistics getStatistics() const {
+            AllocationStatistics statistics;
+
+            statistics.pool_allocations = requests.allocations();
+            statistics.pool_deallocations = requests.deallocations();
+            statistics.heap_allocations = heap.allocations();
+            statistics.heap_deallocations = heap.deallocations();
+            statistics.heap_bytes = heap.bytesInUse();
+            statistics.peak_heap_bytes = heap.peakBytes();
+
+            return statistics;
+        }
+
+    private:
+        // Declared in dependency order, so they are destroyed in reverse
+        CountingResource heap{ std::pmr::new_delete_resource() };
+        std::pmr::unsynchronized_pool_resource pool{ &heap };
+        CountingResource requests{ &pool };
+
+};
+
+#endif // MEMORY_POOL_H_
@@ -2,195 +2,199 @@
 /// @file CS OS Home Project - OS.cpp
 /// @date 2020-04-14
 /// @brief OS class implementation. Implementation details
-/// can be found in function documentation below.
+/// can be found in function documentation below. Operations report
+/// failures through their returned Status and never write to the
+/// console; the interactive front end lives in Console.cpp.
 
-#include <iostream>
 #include <string>
-#include <unordered_map>
+#include <set>
+#include <map>
+#include <algorithm>
 
 #include "DataTypes.h"
 #include "OS.h"
 
-using std::cout;
-using std::cin;
-using std::endl;
 using std::string;
-using std::unordered_map;
-
-// Operations that can be performed by OS
-enum class Operation { A, AR, Q, t, d, D, S };
-
-// Snapshot commands that can be performed by OS
-enum class Snapshot { r, i, m };
-
-// Operation lookup hash table
-const unordered_map<string, Operation> OPERATIONS {
-    {"A",  Operation::A},
-    {"AR", Operation::AR},
-    {"Q",  Operation::Q},
-    {"t",  Operation::t},
-    {"d",  Operation::d},
-    {"D",  Operation::D},
-    {"S",  Operation::S}
-};
-
-// Snapshot lookup hash table
-const unordered_map<string, Snapshot> SNAPSHOTS {
-    {"r", Snapshot::r},
-    {"i", Snapshot::i},
-    {"m", Snapshot::m}
-};
+using std::set;
+using std::map;
 
 /**
- * Reads in argument for a given operation and determines if the input
- * is valid (is an unsigned integer). If not, std::cin is cleared and
- * input stream is ignored. Error is then output to indicate this was
- * an invalid argument.
- * 
- * @param arg Unsigned integer argument to read in
- * 
- * @return False if invalid argument, else true
+ * Describes an operation status, for front ends reporting errors.
+ *
+ * @param status Status returned by an OS operation
+ *
+ * @return Human readable description of the status
  */
-bool isValidOperationArgument(uint & arg) {
-    if ( ! (cin >> arg) ) {
-        cout << "\n\tError - Invalid argument\n" << endl;
-        cin.clear();
-        cin.ignore(256, '\n');
-        return false;
-    }
-    else {
-        return true;
+const char * statusMessage(Status status) {
+    switch ( status ) {
+        case Status::Ok:                    return "Ok";
+        case Status::InvalidSize:           return "Invalid process size of 0";
+        case Status::OutOfMemory:           return "Could not fit new process into memory";
+        case Status::NoRunningProcess:      return "No processes currently being executed";
+        case Status::NoReadyProcess:        return "No processes to execute";
+        case Status::InvalidHDD:            return "Invalid hard drive ID #";
+        case Status::InvalidCore:           return "Invalid core #";
+        case Status::NoServedProcess:       return "No processes currently being served";
+        case Status::CheckpointWriteFailed: return "Could not write checkpoint";
+        case Status::CheckpointReadFailed:  return "Could not restore checkpoint";
+        case Status::TraceOpenFailed:       return "Could not open trace file";
+        case Status::NoSuchProcess:         return "No process with PID #";
     }
+
+    return "Unknown error";
 }
 
 /**
- * Simulates the operating system by prompting the user to enter commands
- * to create or interact with processes used by the CPU and IO devices.
- * Input is sanitized to make sure we don't encounter errors during execution.
- * Operations that can be performed by the user:
+ * Creates new process and sends to ready queue. Will first check
+ * if there is a valid memory block that the process can fit into,
+ * and then create the process, else return an error status. Memory
+ * is taken from the NUMA node of the creating core when possible,
+ * which becomes the process' home node.
  * 
- *  A <#>  - Creates new common process of size #
- *  AR <#> - Creates new real-time process of size #
- *  Q      - Ends time slice of currently executing process
- *  t      - Terminates currently executing process
- *  d <#>  - Send currently running process to hard disk #
- *  D <#>  - Send process being served by hard disk # to ready-queue
- *  S r    - Snapshot of CPU and ready-queues
- *  S i    - Snapshot of IO devices and their IO-queues
- *  S m    - Snapshot of RAM
+ * @param type Process type
+ * @param size Size of process
+ * @param new_PID If not null, set to the PID of the created process
+ * @param core Core creating the process
+ *
+ * @return Ok, InvalidCore, InvalidSize or OutOfMemory
  */
-void OS::run() {
-    string operation{ "" };
-    string snapshot{ "" };
-    uint uint_arg{ 0 };
-
-    while ( true ) {
-        
-        cout << ">> ";
-        cin >> operation;
-
-        // Check if valid operation
-        if ( ! OPERATIONS.count(operation) ) {
-            cout << "\n\tError - Invalid operation: " << operation << '\n' << endl;
-            cin.clear();
-            cin.ignore(256, '\n');
-            continue;
-        }
-
-        switch ( OPERATIONS.at(operation) ) {
-            case Operation::A: // Create new common process
+Status OS::createNewProcess(ProcessType type, uint size, PID * new_PID, uint core) {
+    ScopedLatencyTimer timer( latencyOf(LatencyOperation::CreateProcess) );
 
-                if ( isValidOperationArgument(uint_arg) ) {
-                    createNewProcess(ProcessType::Common, uint_arg);
-                }
-                break;
+    if ( core >= processors.size() ) {
+        return Status::InvalidCore;
+    }
 
-            case Operation::AR: // Create new RT process
+    if ( ! size ) {
+        return Status::InvalidSize;
+    }
 
-                if ( isValidOperationArgument(uint_arg) ) {
-                    createNewProcess(ProcessType::RealTime, uint_arg);
-                }
-                break;
+    // Find memory block to fit new process, local memory first
+    uint local_node{ processors[core].getNode() };
+    MemoryBlock address{ memory.findAvailableMemoryBlock(size, local_node) };
 
-            case Operation::Q: // End time slice for currently running process
+    // Check if valid memory block and create the process
+    if ( address.first <= address.second ) {
+        PID process_ID{ ++PID_counter };
+        uint home_node{ memory.nodeOf( address.first ) };
 
-                executeNextProcess();
-                break;
+        if ( home_node == local_node ) {
+            ++NUMA_statistics.local_allocations;
+        }
+        else {
+            ++NUMA_statistics.remote_allocations;
+        }
 
-            case Operation::t: // Terminate currently running process
+        processes[process_ID] = Process(process_ID, type, address, home_node);
+        tracer.record(TraceEventType::Allocate, TRACK_RAM, process_ID, address.first, address.second);
+        markDirty(process_ID, DIRTY_RAM);
+        sendProcessToReadyQueue(process_ID);
 
-                terminateCurrentProcess();
-                break;
+        if ( new_PID ) {
+            *new_PID = process_ID;
+        }
 
-            case Operation::d: // Send currently running process to IO Queue
+        return Status::Ok;
+    }
+    else {
+        return Status::OutOfMemory;
+    }
+}
 
-                if ( isValidOperationArgument(uint_arg) ) {
-                    sendCurrentProcesstoIOQueue(uint_arg);
-                }
-                break;
+/**
+ * Forks a process. The child gets a new PID and the parent's type and
+ * home node, and shares the parent's memory block instead of copying it:
+ * the block's reference count is raised, and a private copy is only made
+ * when either process writes to it (see writeProcessMemory()). The child
+ * is then sent to the ready-queue.
+ *
+ * @param parent_ID Process to fork
+ * @param new_PID If not null, set to the PID of the child process
+ *
+ * @return Ok or NoSuchProcess
+ */
+Status OS::forkProcess(PID parent_ID, PID * new_PID) {
+    ScopedLatencyTimer timer( latencyOf(LatencyOperation::ForkProcess) );
 
-            case Operation::D: // Send process back form IO to ready-queue
+    auto parent{ processes.find( parent_ID ) };
 
-                if ( isValidOperationArgument(uint_arg) ) {
-                    sendIOProcessToReadyQueue(uint_arg);
-                }
-                break;
+    if ( parent == processes.end() ) {
+        return Status::NoSuchProcess;
+    }
 
-            case Operation::S: // Snapshot command
+    const MemoryBlock address{ parent->second.getMemoryBlock() };
+    PID process_ID{ ++PID_counter };
 
-                cin >> snapshot;
+    // A block becomes a shared region on its first fork, held by the parent
+    auto region{ shared_regions.try_emplace(address.first, SharedRegion{ address.second, 1 }).first };
+    ++region->second.references;
+    ++memory_sharing.forks;
 
-                // Check if valid snapshot
-                if ( ! SNAPSHOTS.count(snapshot) ) {
-                    cout << "\n\tError - Invalid snapshot: " << snapshot << '\n' << endl;
-                    cin.clear();
-                    cin.ignore(256, '\n');
-                    continue;
-                }
-                
-                switch( SNAPSHOTS.at(snapshot) ) {
-                    case Snapshot::r: // Print CPU ready-queue data
-                        printCPUData();
-                        break;
-                    case Snapshot::i: // Print IO-queue data
-                        printIOData();
-                        break;
-                    case Snapshot::m: // Print RAM data
-                        printRAMData();
-                        break;
-                }
-                break;
-        }
+    processes[process_ID] = Process(process_ID, parent->second.getProcessType(), address,
+        parent->second.getHomeNode());
+    tracer.record(TraceEventType::Fork, TRACK_RAM, process_ID, parent_ID);
+    markDirty(process_ID, DIRTY_RAM);
+    sendProcessToReadyQueue(process_ID);
 
+    if ( new_PID ) {
+        *new_PID = process_ID;
     }
+
+    return Status::Ok;
 }
 
 /**
- * Creates new process and sends to ready queue. Will first check
- * if there is a valid memory block that the process can fit into,
- * and then create the process, else output an error message.
- * 
- * @param type Process type
- * @param size Size of process
+ * Writes to a process' memory. Memory that is private to the process is
+ * written in place. Memory shared with forked processes is split first
+ * (copy-on-write): the writer gets a new block of the same size,
+ * preferably on its home node, and the shared block's reference count
+ * is dropped. The last process left in a region keeps the original block.
+ *
+ * @param process_ID Process writing to its memory
+ *
+ * @return Ok, NoSuchProcess or OutOfMemory (memory stays shared)
  */
-void OS::createNewProcess(ProcessType type, uint size) {
-    if ( ! size ) {
-        cout << "\n\tError - Invalid process size of 0\n" << endl;
-        return;
+Status OS::writeProcessMemory(PID process_ID) {
+    ScopedLatencyTimer timer( latencyOf(LatencyOperation::WriteMemory) );
+
+    auto process{ processes.find( process_ID ) };
+
+    if ( process == processes.end() ) {
+        return Status::NoSuchProcess;
     }
 
-    // Find memory block to fit new process
-    MemoryBlock address{ memory.findAvailableMemoryBlock(size) };
+    const MemoryBlock shared_memory{ process->second.getMemoryBlock() };
+    auto region{ shared_regions.find( shared_memory.first ) };
 
-    // Check if valid memory block and create the process
-    if ( address.first <= address.second ) {
-        PID process_ID{ ++PID_counter };
-        processes[process_ID] = Process(process_ID, type, address);
-        sendProcessToReadyQueue(process_ID);
+    if ( region == shared_regions.end() ) {
+        return Status::Ok;
+    }
+
+    uint home_node{ process->second.getHomeNode() };
+    MemoryBlock address{ memory.findAvailableMemoryBlock(shared_memory.second - shared_memory.first + 1, home_node) };
+
+    if ( address.first > address.second ) {
+        return Status::OutOfMemory;
+    }
+
+    if ( memory.nodeOf( address.first ) == home_node ) {
+        ++NUMA_statistics.local_allocations;
     }
     else {
-        cout << "\n\tError - Could not fit new process into memory\n" << endl;
+        ++NUMA_statistics.remote_allocations;
     }
+
+    if ( --region->second.references == 1 ) {
+        shared_regions.erase( region );
+    }
+
+    ++memory_sharing.copy_on_write_splits;
+
+    process->second.setMemoryBlock( address, memory.nodeOf( address.first ) );
+    tracer.record(TraceEventType::Allocate, TRACK_RAM, process_ID, address.first, address.second);
+    markDirty(process_ID, DIRTY_RAM);
+
+    return Status::Ok;
 }
 
 /**
@@ -200,10 +204,15 @@ void OS::createNewProcess(ProcessType type, uint size) {
  * @param process_ID Process to send to ready-queue
  */
 void OS::sendProcessToReadyQueue(PID process_ID) {
-    if ( getProcessType( process_ID ) == ProcessType::Common ) {
+    ProcessType type{ getProcessType( process_ID ) };
+
+    tracer.record(TraceEventType::Ready, TRACK_READY, process_ID, static_cast<uint>(type));
+    setProcessState(process_ID, ProcessState::Ready);
+
+    if ( type == ProcessType::Common ) {
         common_queue.push_back( process_ID );
     }
-    else if ( getProcessType( process_ID ) == ProcessType::RealTime ) {
+    else if ( type == ProcessType::RealTime ) {
         RT_queue.push_back( process_ID );
     }
     else {
@@ -215,98 +224,275 @@ void OS::sendProcessToReadyQueue(PID process_ID) {
 }
 
 /**
- * Terminates currently running process. Deletes process from OS's set
- * of processes and frees the memory it was occupying.
+ * Terminates process running on a core. Deletes process from OS's set
+ * of processes and frees the memory it was occupying, unless processes
+ * forked from it (or it was forked from) still share that memory.
+ *
+ * @param core Core whose process is terminated
+ *
+ * @return Ok, InvalidCore or NoRunningProcess
  */
-void OS::terminateCurrentProcess() {
+Status OS::terminateCurrentProcess(uint core) {
+    ScopedLatencyTimer timer( latencyOf(LatencyOperation::TerminateProcess) );
+
+    if ( core >= processors.size() ) {
+        return Status::InvalidCore;
+    }
+
+    CPU & processor{ processors[core] };
+
     if ( processor.isRunning() ) {
         PID prev_process{ processor.currentProcessPID() };
-        const MemoryBlock & prev_memory{ processes.at(prev_process).getMemoryBlock() };
+        MemoryBlock prev_memory{ processes.at(prev_process).getMemoryBlock() };
 
         processor.finishRunningCurrentProcess();
+        markDirty(prev_process, DIRTY_CPU | DIRTY_RAM);
         processes.erase( prev_process );
-        memory.freeMemoryBlock( prev_memory );
+
+        if ( releaseMemoryBlock( prev_memory ) ) {
+            tracer.record(TraceEventType::Free, TRACK_RAM, prev_process, prev_memory.first, prev_memory.second);
+        }
+        else {
+            released_processes.emplace( prev_process, false );
+        }
 
         updateCPU();
+        return Status::Ok;
     }
     else {
-        cout << "\n\tError - No processes currently being executed\n" << endl;
+        return Status::NoRunningProcess;
     }
 }
 
 /**
- * Stops execution of current process and sends it to the back of the
- * ready-queue, and the next process is executed.
+ * Stops execution of process running on a core and sends it to the back
+ * of the ready-queue, and the next process is executed.
+ *
+ * @param core Core whose time slice ends
+ *
+ * @return Ok, InvalidCore or NoReadyProcess
  */
-void OS::executeNextProcess() {
+Status OS::executeNextProcess(uint core) {
+    ScopedLatencyTimer timer( latencyOf(LatencyOperation::ExecuteNext) );
+
+    if ( core >= processors.size() ) {
+        return Status::InvalidCore;
+    }
+
+    CPU & processor{ processors[core] };
+
     if ( processor.isRunning() ) {
         PID prev_process{ processor.currentProcessPID() };
         processor.finishRunningCurrentProcess();
         sendProcessToReadyQueue( prev_process );
+        return Status::Ok;
     }
     else if ( ! RT_queue.empty() || ! common_queue.empty() ) {
         /* Potential error... should never reach this block
             unless manipulating ready-queues and CPU */
         updateCPU();
+        return Status::Ok;
     }
     else {
-        cout << "\n\tError - No processes to execute\n" << endl;
+        return Status::NoReadyProcess;
     }
 }
 
 /**
- * Updates the CPU to ensure it's running a process if the ready-queues
- * are not empty. This function will preempt a common process if there
- * is a real-time process to be executed. Otherwise it will first send
- * the available real-time processes to the CPU, and if there are none,
- * then it will send the common processes.
+ * Updates the CPU cores to ensure they're running processes if the
+ * ready-queues are not empty. Idle cores are given the available
+ * real-time processes first, and if there are none, the common
+ * processes. Then, while real-time processes are still waiting, a
+ * common process is preempted, preferably on a core of the waiting
+ * process' home node. With a single core this is the original policy:
+ * run RT first, and preempt a running common process for a RT one.
  */
 void OS::updateCPU() {
-    if ( processor.isRunning() ) {
-        // Preempt common process if applicable
-        if ( currentlyRunningProcessType() == ProcessType::Common && ! RT_queue.empty() ) {
-            PID old_process{ processor.currentProcessPID() };
-            common_queue.push_front( old_process );
-            processor.runNewProcess( RT_queue.front() );
-            RT_queue.pop_front();
+    ScopedLatencyTimer timer( latencyOf(LatencyOperation::UpdateCPU) );
+
+    // Run processes on idle cores
+    for (uint core{0}; core < processors.size(); ++core) {
+        if ( processors[core].isRunning() ) {
+            continue;
         }
-    }
-    else {
+
         if ( ! RT_queue.empty() ) {
-            processor.runNewProcess( RT_queue.front() );
-            RT_queue.pop_front();
+            runProcess(core, RT_queue, selectProcess(RT_queue, processors[core].getNode()));
         }
         else if ( ! common_queue.empty() ) {
-            processor.runNewProcess( common_queue.front() );
-            common_queue.pop_front();
+            runProcess(core, common_queue, selectProcess(common_queue, processors[core].getNode()));
+        }
+    }
+
+    // Preempt common processes if applicable
+    while ( ! RT_queue.empty() ) {
+        uint home_node{ processes.at( RT_queue.front() ).getHomeNode() };
+        uint victim{ static_cast<uint>(processors.size()) };
+
+        for (uint core{0}; core < processors.size(); ++core) {
+            if ( currentlyRunningProcessType(core) == ProcessType::Common ) {
+                if ( victim == processors.size() || processors[core].getNode() == home_node ) {
+                    victim = core;
+                }
+
+                if ( processors[core].getNode() == home_node ) {
+                    break;
+                }
+            }
+        }
+
+        if ( victim == processors.size() ) {
+            break;
+        }
+
+        PID old_process{ processors[victim].currentProcessPID() };
+        auto next_process{ selectProcess(RT_queue, processors[victim].getNode()) };
+
+        processors[victim].finishRunningCurrentProcess();
+        common_queue.push_front( old_process );
+        setProcessState(old_process, ProcessState::Ready);
+
+        tracer.record(TraceEventType::Preempt, TRACK_CPU + victim, old_process, *next_process, victim);
+        runProcess(victim, RT_queue, next_process);
+    }
+}
+
+/**
+ * Picks the process an idle core on a NUMA node should run: the first
+ * process near the front of the ready-queue whose home node is that
+ * node, else the front of the queue. Looking only NUMA_AFFINITY_WINDOW
+ * processes deep keeps the scan short and stops remote processes from
+ * being starved by a stream of local ones.
+ *
+ * @param queue Ready-queue to pick from (must not be empty)
+ * @param node NUMA node of the idle core
+ *
+ * @return Position of the process to run in the ready-queue
+ */
+ReadyQueue::iterator OS::selectProcess(ReadyQueue & queue, uint node) {
+    auto window_end{ queue.begin() + std::min(queue.size(), NUMA_AFFINITY_WINDOW) };
+
+    for (auto process{ queue.begin() }; process != window_end; ++process) {
+        if ( processes.at( *process ).getHomeNode() == node ) {
+            return process;
         }
     }
+
+    return queue.begin();
+}
+
+/**
+ * Removes a process from its ready-queue and runs it on an idle core,
+ * counting whether it runs on its home node and whether it migrated
+ * from the node it last ran on.
+ *
+ * @param core Idle core to run the process on
+ * @param queue Ready-queue holding the process
+ * @param process Position of the process in the ready-queue
+ */
+void OS::runProcess(uint core, ReadyQueue & queue, ReadyQueue::iterator process) {
+    PID process_ID{ *process };
+    Process & next_process{ processes.at( process_ID ) };
+    uint node{ processors[core].getNode() };
+
+    queue.erase( process );
+    processors[core].runNewProcess( process_ID );
+    setProcessState(process_ID, ProcessState::Running, core);
+
+    if ( next_process.getHomeNode() == node ) {
+        ++NUMA_statistics.local_dispatches;
+    }
+    else {
+        ++NUMA_statistics.remote_dispatches;
+    }
+
+    if ( next_process.getLastNode() != NO_NODE && next_process.getLastNode() != node ) {
+        ++NUMA_statistics.migrations;
+    }
+
+    next_process.setLastNode( node );
+
+    tracer.record(TraceEventType::Dispatch, TRACK_CPU + core, process_ID,
+        static_cast<uint>(next_process.getProcessType()), core);
 }
 
 /**
- * Sends the CPU's currently running process to the corresponding
- * IO-queue. Check if the HDD # is valid and that the CPU is
+ * Assigns cores to NUMA nodes in contiguous groups, e.g. 4 cores on 2
+ * nodes gives cores 0-1 to node 0 and cores 2-3 to node 1.
+ *
+ * @param core_count Number of cores (at least 1 is created)
+ */
+void OS::createCores(uint core_count) {
+    if ( ! core_count ) {
+        core_count = 1;
+    }
+
+    processors.clear();
+
+    for (uint core{0}; core < core_count; ++core) {
+        unsigned long long node{ static_cast<unsigned long long>(core) * memory.getNodeCount() / core_count };
+        processors.emplace_back( static_cast<uint>(node) );
+    }
+}
+
+/**
+ * Creates the HDDs with IO-queues allocating from the OS's pool. Space is
+ * reserved up front so the HDDs are never copied, which would give the
+ * copies IO-queues on the default heap.
+ *
+ * @param HDD_count Number of HDDs
+ */
+void OS::createHardDrives(uint HDD_count) {
+    hard_drives.clear();
+    hard_drives.reserve( HDD_count );
+
+    for (uint i{0}; i < HDD_count; ++i) {
+        hard_drives.emplace_back( resource );
+    }
+}
+
+/**
+ * Sends a core's currently running process to the corresponding
+ * IO-queue. Check if the HDD # is valid and that the core is
  * running before manipulating any ready-queues or PIDs.
  * 
  * @param HDD_ID Hard drive # to send currently running process to
+ * @param core Core whose running process is sent
+ *
+ * @return Ok, InvalidCore, InvalidHDD or NoRunningProcess
  */
-void OS::sendCurrentProcesstoIOQueue(uint HDD_ID) {
+Status OS::sendCurrentProcesstoIOQueue(uint HDD_ID, uint core) {
+    ScopedLatencyTimer timer( latencyOf(LatencyOperation::SendToIO) );
+
+    if ( core >= processors.size() ) {
+        return Status::InvalidCore;
+    }
+
+    CPU & processor{ processors[core] };
+
     // Check if valid HDD #
     if ( hard_drives.size() > HDD_ID ) {
         if ( processor.isRunning() ) {
             PID IO_process{ processor.currentProcessPID() };
 
+            PID served_process{ hard_drives[HDD_ID].currentProcessPID() };
+
             processor.finishRunningCurrentProcess();
             hard_drives[HDD_ID].sentProcessToIOQueue( IO_process );
 
+            tracer.record(TraceEventType::IOEnqueue, tracer.HDDTrack(HDD_ID), IO_process, HDD_ID);
+            setProcessState(IO_process, ProcessState::IOWaiting, HDD_ID);
+            noteIOServe(HDD_ID, served_process);
+
             updateCPU();
+            return Status::Ok;
         }
         else {
-            cout << "\n\tError - No processes currently being executed\n" << endl;
+            return Status::NoRunningProcess;
         }
     }
     else {
-        cout << "\n\tError - Invalid hard drive ID #\n" << endl;
+        return Status::InvalidHDD;
     }
 }
 
@@ -315,77 +501,555 @@ void OS::sendCurrentProcesstoIOQueue(uint HDD_ID) {
  * that the HDD # is valid and that the HDD is currently serving a process.
  * 
  * @param HDD_ID Hard drive # to stop serving current process
+ *
+ * @return Ok, InvalidHDD or NoServedProcess
  */
-void OS::sendIOProcessToReadyQueue(uint HDD_ID) {
+Status OS::sendIOProcessToReadyQueue(uint HDD_ID) {
+    ScopedLatencyTimer timer( latencyOf(LatencyOperation::ReturnFromIO) );
+
     // Check if valid HDD #
     if ( hard_drives.size() > HDD_ID ) {
         if ( hard_drives[HDD_ID].isServing() ) {
             PID IO_process{ hard_drives[HDD_ID].currentProcessPID() };
             hard_drives[HDD_ID].finishServingCurrentProcess();
+            noteIOServe(HDD_ID, IO_process);
             sendProcessToReadyQueue( IO_process );
+            return Status::Ok;
         }
         else {
-            cout << "\n\tError - No processes currently being served\n" << endl;
+            return Status::NoServedProcess;
         }
     }
     else {
-        cout << "\n\tError - Invalid hard drive ID #\n" << endl;
+        return Status::InvalidHDD;
     }
 }
 
-void OS::printCPUData() const {
-    cout << "\n\tPID\tTYPE\tSTATUS" << endl;
+/**
+ * Writes the full simulator state to a checkpoint image. The image is a
+ * header (magic, version) followed by the PID counter, RAM, CPU cores,
+ * both ready-queues, every HDD and finally the process table:
+ *
+ *  PID_counter | RAM | core count | CPU... | RT_queue | common_queue |
+ *  HDD count | HDD... | process count | (PID, type, M_START, M_END)...
+ *
+ * Core NUMA nodes and process home nodes are not stored, as they follow
+ * from the RAM's node count and the core count.
+ *
+ * @param file_name Path of checkpoint file to write
+ *
+ * @return Ok or CheckpointWriteFailed
+ */
+Status OS::saveCheckpoint(const string & file_name) const {
+    CheckpointWriter writer;
 
-    // Output CPU's currently running process first if it's running
-    if ( processor.isRunning() ) {
-        PID process_ID{ processor.currentProcessPID() };
-        string process_type{ getProcessType( process_ID ) == ProcessType::Common ? "Common" : "RT" };
-        cout << '\t' << process_ID << '\t' << process_type << '\t' << "Running" << endl; 
+    writer.write( CHECKPOINT_MAGIC );
+    writer.write( CHECKPOINT_VERSION );
+    writer.write( PID_counter );
+
+    memory.saveState( writer );
+    writer.write( static_cast<std::uint32_t>(processors.size()) );
+
+    for (const CPU & processor : processors) {
+        processor.saveState( writer );
     }
 
-    // Output RT ready-queue
-    for (PID process : RT_queue) {
-        cout << '\t' << process << '\t' << "RT" << '\t' << "Waiting" << endl; 
+    writer.write( RT_queue );
+    writer.write( common_queue );
+
+    writer.write( static_cast<std::uint32_t>(hard_drives.size()) );
+
+    for (const HDD & hard_drive : hard_drives) {
+        hard_drive.saveState( writer );
     }
-    
-    // Output common ready-queue
-    for (PID process : common_queue) {
-        cout << '\t' << process << '\t' << "Common" << '\t' << "Waiting" << endl; 
+
+    writer.write( static_cast<std::uint32_t>(processes.size()) );
+
+    for (const auto & process : processes) {
+        const MemoryBlock & memory{ process.second.getMemoryBlock() };
+        writer.write( process.first );
+        writer.write( static_cast<std::uint32_t>(process.second.getProcessType()) );
+        writer.write( memory.first );
+        writer.write( memory.second );
+        writer.write( process.second.getLastNode() );
     }
 
-    cout << endl;
+    NUMA_statistics.saveState( writer );
+    memory_sharing.saveState( writer );
+
+    return writer.saveToFile( file_name ) ? Status::Ok : Status::CheckpointWriteFailed;
 }
 
-void OS::printIOData() const {
-    cout << "\n\tPID\tHDD\tSTATUS" << endl;
+/**
+ * Restores the full simulator state from a checkpoint image written by
+ * saveCheckpoint(). The file is memory mapped and decoded into a scratch
+ * OS, which only replaces this one once the whole image has been checked
+ * for consistency: every PID held by a core, a ready-queue or a HDD must
+ * be a known process, each process must be held in exactly one place and
+ * lie within a single NUMA node, a running process must have last run on
+ * its core's node, and process memory and free memory must
+ * tile the RAM exactly, without gaps or overlaps (processes may only
+ * share identical, forked blocks). A rejected image leaves the current
+ * state untouched.
+ *
+ * @param file_name Path of checkpoint file to restore
+ *
+ * @return Ok, or CheckpointReadFailed if the file is missing, truncated
+ * or inconsistent
+ */
+Status OS::loadCheckpoint(const string & file_name) {
+    MappedFile file( file_name );
+
+    if ( ! file.isOpen() ) {
+        return Status::CheckpointReadFailed;
+    }
 
-    for (size_t i{0}; i < hard_drives.size(); ++i) {
-        // Output HDD's current process first if it's serving
+    CheckpointReader reader( file.data(), file.size() );
+    std::uint32_t magic{ 0 };
+    std::uint32_t version{ 0 };
+
+    if ( ! reader.read(magic) || ! reader.read(version) ||
+         magic != CHECKPOINT_MAGIC || version != CHECKPOINT_VERSION ) {
+        return Status::CheckpointReadFailed;
+    }
+
+    OS restored( 1, 0, 1, 1, resource );
+    std::uint32_t core_count{ 0 };
+    std::uint32_t HDD_count{ 0 };
+    std::uint32_t process_count{ 0 };
+
+    reader.read( restored.PID_counter );
+
+    if ( ! restored.memory.loadState(reader) ||
+         ! reader.read(core_count) || ! core_count || core_count > reader.remainingWords() ) {
+        return Status::CheckpointReadFailed;
+    }
+
+    restored.createCores( core_count );
+
+    for (CPU & processor : restored.processors) {
+        if ( ! processor.loadState(reader) ) {
+            return Status::CheckpointReadFailed;
+        }
+    }
+
+    if ( ! reader.read(restored.RT_queue) ||
+         ! reader.read(restored.common_queue) ||
+         ! reader.read(HDD_count) || HDD_count > reader.remainingWords() ) {
+        return Status::CheckpointReadFailed;
+    }
+
+    restored.createHardDrives( HDD_count );
+
+    for (HDD & hard_drive : restored.hard_drives) {
+        if ( ! hard_drive.loadState(reader) ) {
+            return Status::CheckpointReadFailed;
+        }
+    }
+
+    if ( ! reader.read(process_count) || process_count > reader.remainingWords() / 5 ) {
+        return Status::CheckpointReadFailed;
+    }
+
+    // Blocks by start address; processes may only share identical blocks
+    map<uint, SharedRegion> regions;
+
+    for (std::uint32_t i{0}; i < process_count; ++i) {
+        PID process_ID{ 0 };
+        std::uint32_t type{ 0 };
+        MemoryBlock address;
+        std::uint32_t last_node{ 0 };
+
+        reader.read( process_ID );
+        reader.read( type );
+        reader.read( address.first );
+        reader.read( address.second );
+        reader.read( last_node );
+
+        if ( ! process_ID || process_ID > restored.PID_counter ||
+             type >= static_cast<std::uint32_t>(ProcessType::Invalid) ||
+             address.first > address.second ||
+             ( last_node != NO_NODE && last_node >= restored.memory.getNodeCount() ) ||
+             restored.processes.count(process_ID) ) {
+            return Status::CheckpointReadFailed;
+        }
+
+        // Blocks never span two NUMA nodes, or freeing one would give a
+        // zone addresses of the next one
+        if ( ! restored.memory.getZone( restored.memory.nodeOf(address.first) ).contains(address) ) {
+            return Status::CheckpointReadFailed;
+        }
+
+        auto region{ regions.try_emplace(address.first, SharedRegion{ address.second, 0 }).first };
+
+        if ( region->second.end != address.second ) {
+            return Status::CheckpointReadFailed;
+        }
+
+        ++region->second.references;
+
+        restored.processes[process_ID] = Process(process_ID, static_cast<ProcessType>(type), address,
+            restored.memory.nodeOf( address.first ));
+        restored.processes[process_ID].setLastNode( last_node );
+    }
+
+    // Reference counts are not stored in the image, rebuild them
+    for (const auto & region : regions) {
+        if ( region.second.references > 1 ) {
+            restored.shared_regions.insert( region );
+        }
+    }
+
+    if ( ! restored.NUMA_statistics.loadState(reader) ||
+         ! restored.memory_sharing.loadState(reader) || ! reader.atEnd() ) {
+        return Status::CheckpointReadFailed;
+    }
+
+    // Every process must be held by exactly one of cores, ready-queues or HDDs
+    set<PID> held_processes;
+    size_t held_count{ 0 };
+
+    auto hold = [&](PID process_ID) {
+        held_processes.insert( process_ID );
+        ++held_count;
+    };
+
+    for (const CPU & processor : restored.processors) {
+        if ( processor.isRunning() ) {
+            hold( processor.currentProcessPID() );
+        }
+    }
+
+    for (PID process : restored.RT_queue) {
+        hold( process );
+
+        if ( restored.getProcessType(process) != ProcessType::RealTime ) {
+            return Status::CheckpointReadFailed;
+        }
+    }
+
+    for (PID process : restored.common_queue) {
+        hold( process );
+
+        if ( restored.getProcessType(process) != ProcessType::Common ) {
+            return Status::CheckpointReadFailed;
+        }
+    }
+
+    for (const HDD & hard_drive : restored.hard_drives) {
+        if ( hard_drive.isServing() ) {
+            hold( hard_drive.currentProcessPID() );
+        }
+
+        for (PID process : hard_drive.getIOQueue()) {
+            hold( process );
+        }
+    }
+
+    if ( held_count != held_processes.size() || held_count != restored.processes.size() ) {
+        return Status::CheckpointReadFailed;
+    }
+
+    for (PID process : held_processes) {
+        if ( ! restored.processes.count(process) ) {
+            return Status::CheckpointReadFailed;
+        }
+    }
+
+    for (const CPU & processor : restored.processors) {
+        if ( processor.isRunning() &&
+             restored.processes.at( processor.currentProcessPID() ).getLastNode() != processor.getNode() ) {
+            return Status::CheckpointReadFailed;
+        }
+    }
+
+    // Process blocks (shared ones once) and free blocks, by start address,
+    // must each begin right after the previous one and end at the RAM size
+    map<uint, uint> memory_blocks;
+
+    for (const auto & region : regions) {
+        memory_blocks.emplace( region.first, region.second.end );
+    }
+
+    for (uint node{0}; node < restored.memory.getNodeCount(); ++node) {
+        for (const MemoryBlock & free_memory : restored.memory.getZone(node).getAvailableMemory()) {
+            if ( ! memory_blocks.emplace(free_memory.first, free_memory.second).second ) {
+                return Status::CheckpointReadFailed;
+            }
+        }
+    }
+
+    unsigned long long next_address{ 0 };
+
+    for (const auto & block : memory_blocks) {
+        if ( block.first != next_address ) {
+            return Status::CheckpointReadFailed;
+        }
+
+        next_address = block.second + 1ull;
+    }
+
+    if ( next_address != restored.memory.getMemorySize() ) {
+        return Status::CheckpointReadFailed;
+    }
+
+    // Replace simulator state only; tracing carries on across restores
+    processors = std::move( restored.processors );
+    memory = std::move( restored.memory );
+    hard_drives = std::move( restored.hard_drives );
+    RT_queue = std::move( restored.RT_queue );
+    common_queue = std::move( restored.common_queue );
+    processes = std::move( restored.processes );
+    shared_regions = std::move( restored.shared_regions );
+    PID_counter = restored.PID_counter;
+    NUMA_statistics = restored.NUMA_statistics;
+    memory_sharing = restored.memory_sharing;
+
+    // Queue states are not stored in the image, rebuild them from the queues
+    for (uint core{0}; core < processors.size(); ++core) {
+        if ( processors[core].isRunning() ) {
+            processes.at( processors[core].currentProcessPID() ).setProcessState(ProcessState::Running, core);
+        }
+    }
+
+    for (uint i{0}; i < hard_drives.size(); ++i) {
         if ( hard_drives[i].isServing() ) {
-            PID process_ID{ hard_drives[i].currentProcessPID() };
-            cout << '\t' << process_ID << '\t' << i << '\t' << "Serving" << endl;
+            processes.at( hard_drives[i].currentProcessPID() ).setProcessState(ProcessState::IOServing, i);
         }
 
-        // Output HDD's IO-queue
         for (PID process : hard_drives[i].getIOQueue()) {
-            cout << '\t' << process << '\t' << i << '\t' << "Waiting" << endl;
+            processes.at( process ).setProcessState(ProcessState::IOWaiting, i);
         }
     }
 
-    cout << endl;
+    for (DirtyList & dirty_list : dirty_processes) {
+        dirty_list.clear();
+    }
+
+    released_processes.clear();
+
+    snapshot_resync.fill( true );
+
+    tracer.nameTracks( processors.size(), hard_drives.size() );
+    return Status::Ok;
 }
 
-void OS::printRAMData() const {
-    cout << "\n\tPID\tM_START\tM_END" << endl;
+/**
+ * Starts tracing simulator events to a Chrome trace JSON file, replacing
+ * any trace already in progress.
+ *
+ * @param file_name Path of trace file to write
+ *
+ * @return Ok or TraceOpenFailed
+ */
+Status OS::startTrace(const string & file_name) {
+    return tracer.start( file_name, processors.size(), hard_drives.size() ) ? Status::Ok : Status::TraceOpenFailed;
+}
+
+void OS::stopTrace() {
+    tracer.stop();
+}
+
+/**
+ * Updates process state and records an IO serve event if the given HDD
+ * started serving a new process since previous_process was sampled.
+ * HDDs pick their next process internally, so callers sample the served
+ * PID beforehand.
+ *
+ * @param HDD_ID Hard drive # to check
+ * @param previous_process PID served by the HDD before the update
+ */
+void OS::noteIOServe(uint HDD_ID, PID previous_process) {
+    const HDD & hard_drive{ hard_drives[HDD_ID] };
+
+    if ( hard_drive.isServing() && hard_drive.currentProcessPID() != previous_process ) {
+        setProcessState(hard_drive.currentProcessPID(), ProcessState::IOServing, HDD_ID);
+        tracer.record(TraceEventType::IOServe, tracer.HDDTrack(HDD_ID), hard_drive.currentProcessPID(), HDD_ID);
+    }
+}
+
+/**
+ * Moves a process to a new queue state and marks it dirty in every
+ * snapshot view it leaves or enters. Ready and Running processes are
+ * part of the CPU view, IOWaiting and IOServing ones of the IO view.
+ *
+ * @param process_ID Process whose state changed
+ * @param state New process state
+ * @param HDD_ID Hard drive # for IO states
+ */
+void OS::setProcessState(PID process_ID, ProcessState state, uint HDD_ID) {
+    auto process{ processes.find( process_ID ) };
+
+    if ( process == processes.end() ) {
+        return;
+    }
+
+    auto viewOf = [](ProcessState process_state) {
+        bool in_CPU{ process_state == ProcessState::Ready || process_state == ProcessState::Running };
+        return in_CPU ? DIRTY_CPU : DIRTY_IO;
+    };
+
+    uint flags{ viewOf( process->second.getProcessState() ) | viewOf( state ) };
+
+    process->second.setProcessState(state, HDD_ID);
+    markDirty(process_ID, flags);
+}
+
+/**
+ * Drops a terminated process' reference to its memory block, and frees
+ * the block unless other processes still share it.
+ *
+ * @param block Memory block of the terminated process
+ *
+ * @return True if the block was freed, else false
+ */
+bool OS::releaseMemoryBlock(const MemoryBlock & block) {
+    auto region{ shared_regions.find( block.first ) };
+
+    if ( region != shared_regions.end() ) {
+        if ( --region->second.references == 1 ) {
+            shared_regions.erase( region );
+        }
+
+        return false;
+    }
+
+    memory.freeMemoryBlock( block );
+    return true;
+}
+
+/**
+ * Adds up memory sharing: every process' block counts towards mapped
+ * bytes, and blocks shared by forked processes count once towards shared
+ * bytes, so the memory saved by sharing is mapped - private - shared.
+ *
+ * @return Current byte counts and the fork and copy-on-write counters
+ */
+MemorySharing OS::getMemorySharing() const {
+    MemorySharing sharing{ memory_sharing };
+    unsigned long long shared_mapped_bytes{ 0 };
 
-    /* Output processes (in order of PID) and their
-        starting and ending memory address blocks */
     for (const auto & process : processes) {
-        const MemoryBlock & memory{ process.second.getMemoryBlock() };
-        cout << '\t' << process.first << '\t' << memory.first << '\t' << memory.second << endl; 
+        const MemoryBlock & block{ process.second.getMemoryBlock() };
+        sharing.mapped_bytes += block.second - block.first + 1;
+    }
+
+    for (const auto & region : shared_regions) {
+        unsigned long long size{ region.second.end - region.first + 1ull };
+
+        sharing.shared_bytes += size;
+        shared_mapped_bytes += size * region.second.references;
+    }
+
+    sharing.private_bytes = sharing.mapped_bytes - shared_mapped_bytes;
+    return sharing;
+}
+
+/**
+ * Marks a process as changed in the given snapshot views. The process'
+ * dirty flags make sure it is listed at most once per view, so each
+ * delta snapshot only visits the processes that actually changed.
+ *
+ * @param process_ID Process that changed
+ * @param flags Snapshot views affected (DIRTY_* flags)
+ */
+void OS::markDirty(PID process_ID, uint flags) {
+    auto process{ processes.find( process_ID ) };
+
+    if ( process == processes.end() ) {
+        return;
+    }
+
+    for (size_t view{0}; view < dirty_processes.size(); ++view) {
+        uint flag{ dirtyFlag( static_cast<SnapshotView>(view) ) };
+
+        if ( (flags & flag) && ! process->second.isDirty(flag) ) {
+            if ( dirty_processes[view].size() >= std::max(DIRTY_LIST_COMPACT_SIZE, 2 * processes.size()) ) {
+                compactDirtyList(view);
+            }
+
+            process->second.markDirty(flag);
+            dirty_processes[view].push_back(process_ID);
+        }
     }
+}
+
+/**
+ * Drops terminated processes from a view's dirty list, so a view that is
+ * never snapshot does not grow its list (and allocate) without bound.
+ * Their removal can no longer be reported, so the view's next delta is
+ * a full snapshot instead.
+ *
+ * @param view Snapshot view (index of its DIRTY_* flag)
+ */
+void OS::compactDirtyList(size_t view) {
+    DirtyList & dirty_list{ dirty_processes[view] };
+
+    auto terminated{ std::remove_if(dirty_list.begin(), dirty_list.end(),
+        [this](PID process_ID) { return ! processes.count( process_ID ); }) };
+
+    if ( terminated != dirty_list.end() ) {
+        dirty_list.erase( terminated, dirty_list.end() );
+        snapshot_resync[view] = true;
 
-    cout << endl;
+        // No terminated process is left to report
+        if ( static_cast<SnapshotView>(view) == SnapshotView::RAM ) {
+            released_processes.clear();
+        }
+    }
+}
+
+/**
+ * Takes the list of processes changed in a snapshot view since its last
+ * snapshot, in PID order, and clears their dirty flag for that view. The
+ * list is swapped with the one taken last time, so both stay in the pool
+ * and keep their capacity: neither marking processes dirty nor taking a
+ * snapshot allocates until a list outgrows the largest one seen so far.
+ * If the view needs a full resync (the state was restored from a
+ * checkpoint) full is set, and the caller must take a full snapshot
+ * instead.
+ *
+ * @param snapshot_view Snapshot view
+ * @param full Set to true if a full snapshot is required
+ *
+ * @return Processes changed in the view, including terminated ones. Valid
+ * until the next call for the same view
+ */
+const DirtyList & OS::takeDirtyProcesses(SnapshotView snapshot_view, bool & full) {
+    size_t view{ static_cast<size_t>(snapshot_view) };
+    uint flag{ dirtyFlag(snapshot_view) };
+    DirtyList & changed{ taken_processes[view] };
+
+    // Forget kept blocks listed by the previous RAM snapshot, the others
+    // are listed by this one
+    if ( snapshot_view == SnapshotView::RAM ) {
+        for (auto released{ released_processes.begin() }; released != released_processes.end(); ) {
+            if ( released->second ) {
+                released = released_processes.erase( released );
+            }
+            else {
+                released->second = true;
+                ++released;
+            }
+        }
+    }
+
+    changed.swap( dirty_processes[view] );
+    dirty_processes[view].clear();
+    std::sort(changed.begin(), changed.end());
+
+    for (PID process_ID : changed) {
+        auto process{ processes.find( process_ID ) };
+
+        if ( process != processes.end() ) {
+            process->second.clearDirty(flag);
+        }
+    }
+
+    full = full || snapshot_resync[view];
+    snapshot_resync[view] = false;
+
+    return changed;
 }
 
 ProcessType OS::getProcessType(PID process_ID) const {
@@ -397,6 +1061,16 @@ ProcessType OS::getProcessType(PID process_ID) const {
     }
 }
 
-ProcessType OS::currentlyRunningProcessType() const {
-    return getProcessType( processor.currentProcessPID() );
+/**
+ * @param core Core to check
+ *
+ * @return Type of process running on the core, or Invalid if the core is
+ * idle or does not exist
+ */
+ProcessType OS::currentlyRunningProcessType(uint core) const {
+    if ( core >= processors.size() ) {
+        return ProcessType::Invalid;
+    }
+
+    return getProcessType( processors[core].currentProcessPID() );
 }
@@ -1,30 +1,134 @@
 /// @author Jonathan Kelaty
 /// @file CS OS Home Project - OS.h
 /// @date 2020-04-14
-/// @brief OS class declaration. Manages CPU, HDD's, RAM, and
-/// processes used in simulated OS. Main driver of the OS is the
-/// run() member function, which accepts and sanitizes input to
-/// perform actions on the OS. CPU has two levels of its ready-queue,
-/// one for common processes and one for real-time processes. RT
-/// processes will preempt common processes when they enter their
-/// ready-queue. Memory is a contiguous first-fit approach. The HDD's
-/// IO-queues are first come, first served. The PIDs start from 1
-/// using a counter. This implementation does not reuse previous PIDs.
+/// @brief OS class declaration. Manages CPU cores, HDD's, RAM, and
+/// processes used in simulated OS. This is the core of libossim:
+/// operations return a Status instead of writing to the console, and
+/// state is exposed through read-only views of the CPU cores, ready-
+/// queues, HDDs and process table. The interactive front end is the
+/// Console class, which is a client of this API. CPU has two levels of
+/// its ready-queue, one for common processes and one for real-time
+/// processes. RT processes will preempt common processes when they
+/// enter their ready-queue. Memory is a contiguous first-fit approach,
+/// split into NUMA nodes, and forked processes share their parent's
+/// block until one of them writes to it. The HDD's IO-queues are first
+/// come, first served. The PIDs start from 1 using a counter. This
+/// implementation does not reuse previous PIDs.
 
 #ifndef OPERATING_SYSTEM_H_
 #define OPERATING_SYSTEM_H_
 
+#include <array>
+#include <memory_resource>
 #include <vector>
 #include <map>
+#include <string>
 
 #include "DataTypes.h"
 #include "CPU.h"
 #include "RAM.h"
 #include "HDD.h"
 #include "Process.h"
+#include "Checkpoint.h"
+#include "Tracer.h"
+#include "LatencyHistogram.h"
+#include "MemoryPool.h"
 
 using std::vector;
-using std::map;
+using std::string;
+using std::array;
+
+typedef std::pmr::map<PID, Process> ProcessTable;
+typedef std::pmr::vector<PID> DirtyList;
+
+// Size at which a dirty list is compacted if it mostly holds terminated
+// processes (it is compacted once it is also twice the process count)
+const size_t DIRTY_LIST_COMPACT_SIZE{ 1024 };
+
+// Relative cost of running a process on a core outside its home node
+const double NUMA_REMOTE_PENALTY{ 1.5 };
+
+// How far into a ready-queue an idle core looks for a node-local process
+const size_t NUMA_AFFINITY_WINDOW{ 8 };
+
+// NUMA locality counters
+struct NUMAStatistics {
+    unsigned long long local_dispatches{ 0 };
+    unsigned long long remote_dispatches{ 0 };
+    unsigned long long migrations{ 0 };
+    unsigned long long local_allocations{ 0 };
+    unsigned long long remote_allocations{ 0 };
+
+    void saveState(CheckpointWriter & writer) const {
+        writer.write( local_dispatches );
+        writer.write( remote_dispatches );
+        writer.write( migrations );
+        writer.write( local_allocations );
+        writer.write( remote_allocations );
+    }
+
+    bool loadState(CheckpointReader & reader) {
+        reader.read( local_dispatches );
+        reader.read( remote_dispatches );
+        reader.read( migrations );
+        reader.read( local_allocations );
+        return reader.read( remote_allocations );
+    }
+
+    /*
+     * Throughput relative to running every process on its home node,
+     * modelling remote execution as NUMA_REMOTE_PENALTY times slower.
+     */
+    double relativeThroughput() const {
+        unsigned long long dispatches{ local_dispatches + remote_dispatches };
+
+        if ( ! dispatches ) {
+            return 1.0;
+        }
+
+        return dispatches / (local_dispatches + remote_dispatches * NUMA_REMOTE_PENALTY);
+    }
+};
+
+// Memory block shared by forked processes, keyed by its start address
+struct SharedRegion {
+    uint end;
+    uint references;
+};
+
+typedef std::pmr::map<uint, SharedRegion> SharedRegions;
+
+// Memory sharing accounting. Mapped bytes count every process' block,
+// private and shared bytes count the RAM actually used
+struct MemorySharing {
+    unsigned long long private_bytes{ 0 };
+    unsigned long long shared_bytes{ 0 };
+    unsigned long long mapped_bytes{ 0 };
+    unsigned long long forks{ 0 };
+    unsigned long long copy_on_write_splits{ 0 };
+
+    unsigned long long savedBytes() const {
+        return mapped_bytes - private_bytes - shared_bytes;
+    }
+
+    // Byte counts are worked out from the process table, only the
+    // counters are stored
+    void saveState(CheckpointWriter & writer) const {
+        writer.write( forks );
+        writer.write( copy_on_write_splits );
+    }
+
+    bool loadState(CheckpointReader & reader) {
+        reader.read( forks );
+        return reader.read( copy_on_write_splits );
+    }
+};
+
+// OS operations whose latency is recorded
+enum class LatencyOperation {
+    CreateProcess, TerminateProcess, ExecuteNext, UpdateCPU, SendToIO, ReturnFromIO,
+    ForkProcess, WriteMemory, Count
+};
 
 /******************************
  * 
@@ -37,44 +141,164 @@ class OS {
     public:
         OS() = delete;
 
-        OS(uint RAM_size, uint HDD_count) :
-            memory{ RAM_size }, hard_drives{ HDD_count } { /* Intentionally empty */ }
+        OS(uint RAM_size, uint HDD_count, uint node_count = 1, uint core_count = 1) :
+            OS(RAM_size, HDD_count, node_count, core_count, nullptr) { /* Intentionally empty */ }
 
-        void run();
-        
-        void createNewProcess(ProcessType type, uint size);
+        Status createNewProcess(ProcessType type, uint size, PID * new_PID = nullptr, uint core = 0);
+        Status forkProcess(PID parent_ID, PID * new_PID = nullptr);
+        Status writeProcessMemory(PID process_ID);
 
         // CPU Ready-Queue functions
-        void sendProcessToReadyQueue(PID process_ID);
-        void terminateCurrentProcess();
-        void executeNextProcess();
-        void updateCPU();
+        Status terminateCurrentProcess(uint core = 0);
+        Status executeNextProcess(uint core = 0);
 
         // IO-Queue functions
-        void sendCurrentProcesstoIOQueue(uint HDD_ID);
-        void sendIOProcessToReadyQueue(uint HDD_ID);
+        Status sendCurrentProcesstoIOQueue(uint HDD_ID, uint core = 0);
+        Status sendIOProcessToReadyQueue(uint HDD_ID);
+
+        // Snapshot views
+        const vector<CPU> & getCPUs() const {
+            return processors;
+        }
+
+        const RAM & getMemory() const {
+            return memory;
+        }
+
+        const vector<HDD> & getHardDrives() const {
+            return hard_drives;
+        }
 
-        // Snapshots
-        void printCPUData() const;
-        void printIOData() const;
-        void printRAMData() const;
+        const ReadyQueue & getRTQueue() const {
+            return RT_queue;
+        }
+
+        const ReadyQueue & getCommonQueue() const {
+            return common_queue;
+        }
+
+        const ProcessTable & getProcesses() const {
+            return processes;
+        }
+
+        const LatencyHistogram & getLatency(LatencyOperation operation) const {
+            return latencies[static_cast<size_t>(operation)];
+        }
+
+        const NUMAStatistics & getNUMAStatistics() const {
+            return NUMA_statistics;
+        }
+
+        const SharedRegions & getSharedRegions() const {
+            return shared_regions;
+        }
+
+        MemorySharing getMemorySharing() const;
+
+        AllocationStatistics getAllocationStatistics() const {
+            return memory_pool.getStatistics();
+        }
+
+        const DirtyList & takeDirtyProcesses(SnapshotView snapshot_view, bool & full);
+
+        /*
+         * True if a terminated process' memory block was kept because
+         * forked processes still share it. Only known until the RAM
+         * snapshot after the one listing the process is taken.
+         */
+        bool isMemoryBlockKept(PID process_ID) const {
+            return released_processes.count( process_ID );
+        }
+
+        // Checkpoints
+        Status saveCheckpoint(const string & file_name) const;
+        Status loadCheckpoint(const string & file_name);
+
+        // Tracing
+        Status startTrace(const string & file_name);
+        void stopTrace();
 
         // Helpers
         ProcessType getProcessType(PID process_ID) const;
-        ProcessType currentlyRunningProcessType() const;
+        ProcessType currentlyRunningProcessType(uint core = 0) const;
 
     private:
-        CPU processor;
+        /*
+         * Containers allocate from shared_resource if given, else from the
+         * OS's own pool. Checkpoint restores decode into a scratch OS that
+         * shares this OS's pool, so its containers can be moved in as is.
+         */
+        OS(uint RAM_size, uint HDD_count, uint node_count, uint core_count,
+            std::pmr::memory_resource * shared_resource) :
+            resource{ shared_resource ? shared_resource : memory_pool.resource() },
+            memory{ RAM_size, node_count, resource },
+            RT_queue{ resource },
+            common_queue{ resource },
+            processes{ resource },
+            shared_regions{ resource },
+            released_processes{ resource },
+            dirty_processes{ { DirtyList(resource), DirtyList(resource), DirtyList(resource) } },
+            taken_processes{ { DirtyList(resource), DirtyList(resource), DirtyList(resource) } } {
+            createCores( core_count );
+            createHardDrives( HDD_count );
+        }
+
+        // Must be declared (so constructed) before every container using it
+        MemoryPool memory_pool;
+        std::pmr::memory_resource * resource;
+
+        vector<CPU> processors;
         RAM memory;
         vector<HDD> hard_drives;
 
         ReadyQueue RT_queue;
         ReadyQueue common_queue;
 
-        map<PID, Process> processes;
+        ProcessTable processes;
+        SharedRegions shared_regions;
+
+        // Terminated processes whose memory block was kept (still shared),
+        // and whether a RAM snapshot has listed them yet
+        std::pmr::map<PID, bool> released_processes;
 
         PID PID_counter{ 0 };
 
+        Tracer tracer;
+
+        array<LatencyHistogram, static_cast<size_t>(LatencyOperation::Count)> latencies;
+
+        LatencyHistogram & latencyOf(LatencyOperation operation) {
+            return latencies[static_cast<size_t>(operation)];
+        }
+
+        // Processes changed since the last snapshot of each view, the
+        // processes handed out by each view's last snapshot, and views
+        // whose next delta must be a full snapshot (after restore)
+        array<DirtyList, SNAPSHOT_VIEW_COUNT> dirty_processes;
+        array<DirtyList, SNAPSHOT_VIEW_COUNT> taken_processes;
+        array<bool, SNAPSHOT_VIEW_COUNT> snapshot_resync{};
+
+        NUMAStatistics NUMA_statistics;
+        MemorySharing memory_sharing;
+
+        // Internal scheduling, callers must pass a process not on a core,
+        // ready-queue or HDD
+        void sendProcessToReadyQueue(PID process_ID);
+        void updateCPU();
+
+        void createCores(uint core_count);
+        void createHardDrives(uint HDD_count);
+        ReadyQueue::iterator selectProcess(ReadyQueue & queue, uint node);
+        void runProcess(uint core, ReadyQueue & queue, ReadyQueue::iterator process);
+
+        void noteIOServe(uint HDD_ID, PID previous_process);
+        void setProcessState(PID process_ID, ProcessState state, uint HDD_ID = 0);
+        bool releaseMemoryBlock(const MemoryBlock & block);
+        void markDirty(PID process_ID, uint flags);
+        void compactDirtyList(size_t view);
+
 };
 
+const char * statusMessage(Status status);
+
 #endif // OPERATING_SYSTEM_H_
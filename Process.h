@@ -4,13 +4,34 @@
 /// @brief Process class implementation. Contains PID, process type,
 /// and memory location of an individual process. Cannot be modified
 /// directly after initialization unless using copy or move assignment,
-/// which is used only to overwrite an invalid process.
+/// which is used only to overwrite an invalid process. The exceptions
+/// are the process' queue state, which the OS updates as the process
+/// moves between CPU and HDDs, the NUMA node of the core it last ran
+/// on, and its dirty flags, which mark the snapshot views the process
+/// has changed in since they were last taken. A process' home node is
+/// the NUMA node its memory was allocated from.
 
 #ifndef PROCESS_H_
 #define PROCESS_H_
 
 #include "DataTypes.h"
 
+// Snapshot views that a process change can affect, and their dirty flags
+enum class SnapshotView { CPU, IO, RAM, Count };
+
+const size_t SNAPSHOT_VIEW_COUNT{ static_cast<size_t>(SnapshotView::Count) };
+
+constexpr uint dirtyFlag(SnapshotView view) {
+    return 1u << static_cast<uint>(view);
+}
+
+const uint DIRTY_CPU{ dirtyFlag(SnapshotView::CPU) };
+const uint DIRTY_IO{ dirtyFlag(SnapshotView::IO) };
+const uint DIRTY_RAM{ dirtyFlag(SnapshotView::RAM) };
+
+// NUMA node of a process that has not run on any core yet
+const uint NO_NODE{ static_cast<uint>(-1) };
+
 /****************
  * 
  * Process Class
@@ -21,13 +42,16 @@ class Process {
 
     public:
         Process() = default;
+        Process(const Process &) = default;
+        Process(Process &&) = default;
         Process & operator=(const Process &) = default;
         Process & operator=(Process &&) = default;
 
-        Process(PID id, ProcessType type, const MemoryBlock & location) :
+        Process(PID id, ProcessType type, const MemoryBlock & location, uint node = 0) :
             process_id{ id },
             process_type{ type },
-            memory_location{ location } { /* Intentionally empty */ }
+            memory_location{ location },
+            home_node{ node } { /* Intentionally empty */ }
 
         PID getPID() const {
             return process_id;
@@ -41,10 +65,59 @@ class Process {
             return memory_location;
         }
 
+        uint getHomeNode() const {
+            return home_node;
+        }
+
+        // Moves the process to a private copy of its memory (copy-on-write)
+        void setMemoryBlock(const MemoryBlock & location, uint node) {
+            memory_location = location;
+            home_node = node;
+        }
+
+        uint getLastNode() const {
+            return last_node;
+        }
+
+        void setLastNode(uint node) {
+            last_node = node;
+        }
+
+        ProcessState getProcessState() const {
+            return process_state;
+        }
+
+        // HDD # when in an IO state, core # when running
+        uint getDevice() const {
+            return device_ID;
+        }
+
+        void setProcessState(ProcessState state, uint device = 0) {
+            process_state = state;
+            device_ID = device;
+        }
+
+        bool isDirty(uint flags) const {
+            return dirty_flags & flags;
+        }
+
+        void markDirty(uint flags) {
+            dirty_flags |= flags;
+        }
+
+        void clearDirty(uint flags) {
+            dirty_flags &= ~flags;
+        }
+
     private:
         PID process_id{ 0 };
         ProcessType process_type{ ProcessType::Invalid };
         MemoryBlock memory_location{ 1,0 };
+        uint home_node{ 0 };
+        uint last_node{ NO_NODE };
+        ProcessState process_state{ ProcessState::Ready };
+        uint device_ID{ 0 };
+        uint dirty_flags{ 0 };
 
 };
 
@@ -5,17 +5,24 @@
 /// memory in our simulated system. It will find an available memory
 /// block (if possible) given a specified size, and will free a memory
 /// block previously used by a process when it terminated. Implemented
-/// as contiguous first-fit memory allocation.
+/// as contiguous first-fit memory allocation. The address range is
+/// split evenly into NUMA nodes, each a MemoryZone with its own free
+/// memory blocks. Allocations prefer a given node and fall back to the
+/// other nodes in order; blocks never span two nodes. Free memory
+/// blocks are allocated from the memory resource the RAM is given.
 
 #ifndef RAM_H_
 #define RAM_H_
 
+#include <memory_resource>
 #include <set>
+#include <vector>
 #include <iterator>
 
 #include "DataTypes.h"
+#include "Checkpoint.h"
 
-using std::set;
+using std::vector;
 using std::advance;
 
 /*
@@ -29,19 +36,23 @@ struct memory_compare {
     }
 };
 
-/***********************************
+typedef std::pmr::set<MemoryBlock, memory_compare> FreeMemoryBlocks;
+
+/*****************************
  * 
- * Random Access Memory (RAM) Class
+ * NUMA Memory Zone Class
  * 
- ***********************************/
+ *****************************/
 
-class RAM {
+class MemoryZone {
 
     public:
-        RAM() = delete;
+        MemoryZone() = delete;
 
-        RAM(uint size) :
-            available_memory{ {0, size - 1} } { /* Intentionally empty */ }
+        MemoryZone(uint start, uint end, std::pmr::memory_resource * resource) :
+            zone_start{ start },
+            zone_end{ end },
+            available_memory{ {{start, end}}, resource } { /* Intentionally empty */ }
 
         /**
          * Finds an available memory block that fits a process of a desired
@@ -165,8 +176,237 @@ class RAM {
             }
         }
 
+        uint getStart() const {
+            return zone_start;
+        }
+
+        uint getEnd() const {
+            return zone_end;
+        }
+
+        bool contains(const MemoryBlock & memory) const {
+            return zone_start <= memory.first && memory.second <= zone_end;
+        }
+
+        unsigned long long getFreeMemorySize() const {
+            unsigned long long free_size{ 0 };
+
+            for (const MemoryBlock & memory : available_memory) {
+                free_size += memory.second - memory.first + 1;
+            }
+
+            return free_size;
+        }
+
+        const FreeMemoryBlocks & getAvailableMemory() const {
+            return available_memory;
+        }
+
+        /*
+         * Used only when restoring a checkpoint: the zone is emptied, then
+         * its free blocks are added back in increasing address order.
+         */
+        void clearAvailableMemory() {
+            available_memory.clear();
+        }
+
+        void restoreFreeBlock(const MemoryBlock & free_memory) {
+            available_memory.insert( available_memory.end(), free_memory );
+        }
+
+    private:
+        uint zone_start;
+        uint zone_end;
+        FreeMemoryBlocks available_memory;
+
+};
+
+/***********************************
+ * 
+ * Random Access Memory (RAM) Class
+ * 
+ ***********************************/
+
+class RAM {
+
+    public:
+        RAM() = delete;
+
+        RAM(uint size, uint node_count = 1,
+            std::pmr::memory_resource * memory_resource = std::pmr::get_default_resource()) :
+            memory_size{ size }, resource{ memory_resource } {
+            createZones( node_count );
+        }
+
+        /**
+         * Finds an available memory block, trying the preferred NUMA node
+         * first and then every other node in increasing order (wrapping
+         * around), so memory is local whenever the preferred node has room.
+         *
+         * @param size Size of process to fit into RAM (must be > 0)
+         * @param preferred_node NUMA node to try first
+         *
+         * @return Valid memory location if it can be fit, else {1,0}
+         */
+        MemoryBlock findAvailableMemoryBlock(uint size, uint preferred_node = 0) {
+            for (size_t i{0}; i < zones.size(); ++i) {
+                MemoryZone & zone{ zones[(preferred_node + i) % zones.size()] };
+                MemoryBlock memory{ zone.findAvailableMemoryBlock(size) };
+
+                if ( memory.first <= memory.second ) {
+                    return memory;
+                }
+            }
+
+            return {1,0}; // Invalid memory block (first > second)
+        }
+
+        void freeMemoryBlock(const MemoryBlock & free_memory) {
+            zones[nodeOf( free_memory.first )].freeMemoryBlock( free_memory );
+        }
+
+        /**
+         * Finds the NUMA node an address belongs to. Nodes are few, so a
+         * scan of the zone bounds is enough.
+         *
+         * @param address Memory address
+         *
+         * @return NUMA node containing the address
+         */
+        uint nodeOf(uint address) const {
+            for (size_t node{0}; node + 1 < zones.size(); ++node) {
+                if ( zones[node].contains( {address, address} ) ) {
+                    return node;
+                }
+            }
+
+            return zones.size() - 1;
+        }
+
+        uint getNodeCount() const {
+            return zones.size();
+        }
+
+        uint getMemorySize() const {
+            return memory_size;
+        }
+
+        const MemoryZone & getZone(uint node) const {
+            return zones[node];
+        }
+
+        unsigned long long getFreeMemorySize() const {
+            unsigned long long free_size{ 0 };
+
+            for (const MemoryZone & zone : zones) {
+                free_size += zone.getFreeMemorySize();
+            }
+
+            return free_size;
+        }
+
+        void saveState(CheckpointWriter & writer) const {
+            std::uint32_t block_count{ 0 };
+
+            for (const MemoryZone & zone : zones) {
+                block_count += zone.getAvailableMemory().size();
+            }
+
+            writer.write( memory_size );
+            writer.write( static_cast<std::uint32_t>(zones.size()) );
+            writer.write( block_count );
+
+            for (const MemoryZone & zone : zones) {
+                for (const MemoryBlock & memory : zone.getAvailableMemory()) {
+                    writer.write( memory.first );
+                    writer.write( memory.second );
+                }
+            }
+        }
+
+        /**
+         * Restores RAM from a checkpoint image. Free memory blocks are
+         * stored in increasing address order, so the image is rejected
+         * unless every block is valid, lies inside a single NUMA node and
+         * starts after the end of the previous one.
+         *
+         * @param reader Checkpoint image positioned at the RAM's state
+         *
+         * @return False if the image is truncated or inconsistent, else true
+         */
+        bool loadState(CheckpointReader & reader) {
+            std::uint32_t node_count{ 0 };
+            std::uint32_t block_count{ 0 };
+
+            if ( ! reader.read(memory_size) || ! reader.read(node_count) || ! reader.read(block_count) ) {
+                return false;
+            }
+
+            if ( ! memory_size || ! node_count || node_count > memory_size ||
+                 block_count > reader.remainingWords() / 2 ) {
+                return false;
+            }
+
+            createZones( node_count );
+
+            for (MemoryZone & zone : zones) {
+                zone.clearAvailableMemory();
+            }
+
+            uint previous_end{ 0 };
+
+            for (std::uint32_t i{0}; i < block_count; ++i) {
+                MemoryBlock memory;
+                reader.read( memory.first );
+                reader.read( memory.second );
+
+                bool in_order{ i == 0 || previous_end < memory.first };
+
+                if ( memory.first > memory.second || memory.second >= memory_size || ! in_order ) {
+                    return false;
+                }
+
+                MemoryZone & zone{ zones[nodeOf( memory.first )] };
+
+                if ( ! zone.contains(memory) ) {
+                    return false;
+                }
+
+                zone.restoreFreeBlock( memory );
+                previous_end = memory.second;
+            }
+
+            return reader.good();
+        }
+
     private:
-        set<MemoryBlock, memory_compare> available_memory;
+        uint memory_size;
+        std::pmr::memory_resource * resource;
+        vector<MemoryZone> zones;
+
+        /*
+         * Splits the address range evenly into NUMA nodes, the last node
+         * taking any remainder. There are never more nodes than bytes.
+         */
+        void createZones(uint node_count) {
+            if ( ! node_count ) {
+                node_count = 1;
+            }
+
+            if ( memory_size && node_count > memory_size ) {
+                node_count = memory_size;
+            }
+
+            zones.clear();
+            zones.reserve( node_count );
+
+            for (uint node{0}; node < node_count; ++node) {
+                unsigned long long start{ static_cast<unsigned long long>(memory_size) * node / node_count };
+                unsigned long long end{ static_cast<unsigned long long>(memory_size) * (node + 1) / node_count };
+
+                zones.emplace_back( start, end - 1, resource );
+            }
+        }
 
 };
 
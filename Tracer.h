@@ -0,0 +1,241 @@
+/// @author agent
+/// @file CS OS Home Project - Tracer.h
+/// @date 2026-10-18
+/// @brief Tracer class implementation. Records timestamped simulator
+/// events (scheduling, memory and IO-queue activity) into a buffer that
+/// is written out to a Chrome trace JSON file whenever it fills up.
+/// The resulting file can be opened in chrome://tracing or Perfetto.
+/// Tracing is off by default, in which case recording an event costs
+/// a single branch.
+
+#ifndef TRACER_H_
+#define TRACER_H_
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "DataTypes.h"
+
+enum class TraceEventType { Ready, Dispatch, Preempt, Allocate, Free, Fork, IOEnqueue, IOServe };
+
+// Trace tracks (Chrome trace thread IDs). Core # is shown on
+// TRACK_CPU + #, and the HDD tracks follow the cores' (see HDDTrack())
+const uint TRACK_READY{ 0 };
+const uint TRACK_RAM{ 1 };
+const uint TRACK_CPU{ 2 };
+
+// Number of events buffered before they are written out
+const size_t TRACE_BUFFER_SIZE{ 4096 };
+
+struct TraceEvent {
+    std::uint64_t timestamp;
+    TraceEventType type;
+    uint track;
+    PID process;
+    uint arg1;
+    uint arg2;
+};
+
+/***************
+ *
+ * Tracer Class
+ *
+ ***************/
+
+class Tracer {
+
+    public:
+        Tracer() = default;
+        Tracer(const Tracer &) = delete;
+        Tracer & operator=(const Tracer &) = delete;
+
+        ~Tracer() {
+            stop();
+        }
+
+        bool isEnabled() const {
+            return trace_file;
+        }
+
+        /**
+         * Opens a new trace file and starts recording events. A trace that
+         * is already running is finished first. Timestamps are measured in
+         * wall time from the moment tracing starts.
+         *
+         * @param file_name Path of Chrome trace JSON file to write
+         * @param core_count Number of core tracks to name in the trace
+         * @param HDD_count Number of HDD tracks to name in the trace
+         *
+         * @return False if trace file could not be opened, else true
+         */
+        bool start(const std::string & file_name, size_t core_count, size_t HDD_count) {
+            stop();
+
+            trace_file = std::fopen(file_name.c_str(), "w");
+
+            if ( ! trace_file ) {
+                return false;
+            }
+
+            events.reserve( TRACE_BUFFER_SIZE );
+            start_time = std::chrono::steady_clock::now();
+            first_entry = true;
+
+            std::fputs("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n", trace_file);
+            nameTracks( core_count, HDD_count );
+
+            return true;
+        }
+
+        /**
+         * Flushes buffered events and closes the trace file. Does nothing
+         * if tracing is not enabled.
+         */
+        void stop() {
+            if ( ! trace_file ) {
+                return;
+            }
+
+            flush();
+            std::fputs("\n]}\n", trace_file);
+            std::fclose(trace_file);
+            trace_file = nullptr;
+        }
+
+        /**
+         * Names the ready-queue, RAM, core and HDD tracks so they are
+         * labelled when the trace is visualized. Called again whenever the
+         * core or HDD count changes, which also moves the HDD tracks.
+         *
+         * @param core_count Number of core tracks to name
+         * @param HDD_count Number of HDD tracks to name
+         */
+        void nameTracks(size_t core_count, size_t HDD_count) {
+            track_core_count = core_count;
+
+            if ( ! trace_file ) {
+                return;
+            }
+
+            writeTrackName(TRACK_READY, "Ready-queues");
+            writeTrackName(TRACK_RAM, "RAM");
+
+            for (size_t i{0}; i < core_count; ++i) {
+                writeTrackName(TRACK_CPU + i, "CPU " + std::to_string(i));
+            }
+
+            for (size_t i{0}; i < HDD_count; ++i) {
+                writeTrackName(HDDTrack(i), "HDD " + std::to_string(i));
+            }
+        }
+
+        uint HDDTrack(uint HDD_ID) const {
+            return TRACK_CPU + track_core_count + HDD_ID;
+        }
+
+        void record(TraceEventType type, uint track, PID process, uint arg1 = 0, uint arg2 = 0) {
+            if ( ! trace_file ) {
+                return;
+            }
+
+            auto elapsed{ std::chrono::steady_clock::now() - start_time };
+            std::uint64_t timestamp( std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count() );
+
+            events.push_back( {timestamp, type, track, process, arg1, arg2} );
+
+            if ( events.size() == TRACE_BUFFER_SIZE ) {
+                flush();
+            }
+        }
+
+    private:
+        /**
+         * Writes all buffered events as Chrome trace instant events and
+         * empties the buffer. Chrome trace timestamps are in microseconds.
+         */
+        void flush() {
+            for (const TraceEvent & event : events) {
+                beginEntry();
+                std::fprintf(trace_file,
+                    "{\"name\":\"%s\",\"ph\":\"i\",\"s\":\"t\",\"pid\":1,\"tid\":%u,\"ts\":%llu.%03u,\"args\":{",
+                    eventName(event.type), event.track,
+                    static_cast<unsigned long long>(event.timestamp / 1000),
+                    static_cast<uint>(event.timestamp % 1000));
+                writeEventArgs(event);
+                std::fputs("}}", trace_file);
+            }
+
+            events.clear();
+        }
+
+        void writeEventArgs(const TraceEvent & event) {
+            switch ( event.type ) {
+                case TraceEventType::Ready:
+                    std::fprintf(trace_file, "\"pid\":%u,\"queue\":\"%s\"", event.process,
+                        event.arg1 == static_cast<uint>(ProcessType::RealTime) ? "RT" : "Common");
+                    break;
+                case TraceEventType::Dispatch:
+                    std::fprintf(trace_file, "\"pid\":%u,\"queue\":\"%s\",\"core\":%u", event.process,
+                        event.arg1 == static_cast<uint>(ProcessType::RealTime) ? "RT" : "Common", event.arg2);
+                    break;
+                case TraceEventType::Preempt:
+                    std::fprintf(trace_file, "\"pid\":%u,\"by\":%u,\"core\":%u",
+                        event.process, event.arg1, event.arg2);
+                    break;
+                case TraceEventType::Allocate:
+                case TraceEventType::Free:
+                    std::fprintf(trace_file, "\"pid\":%u,\"m_start\":%u,\"m_end\":%u",
+                        event.process, event.arg1, event.arg2);
+                    break;
+                case TraceEventType::Fork:
+                    std::fprintf(trace_file, "\"pid\":%u,\"parent\":%u", event.process, event.arg1);
+                    break;
+                case TraceEventType::IOEnqueue:
+                case TraceEventType::IOServe:
+                    std::fprintf(trace_file, "\"pid\":%u,\"hdd\":%u", event.process, event.arg1);
+                    break;
+            }
+        }
+
+        void writeTrackName(size_t track, const std::string & name) {
+            beginEntry();
+            std::fprintf(trace_file,
+                "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%zu,\"args\":{\"name\":\"%s\"}}",
+                track, name.c_str());
+        }
+
+        void beginEntry() {
+            if ( ! first_entry ) {
+                std::fputs(",\n", trace_file);
+            }
+
+            first_entry = false;
+        }
+
+        static const char * eventName(TraceEventType type) {
+            switch ( type ) {
+                case TraceEventType::Ready:     return "ready";
+                case TraceEventType::Dispatch:  return "dispatch";
+                case TraceEventType::Preempt:   return "preempt";
+                case TraceEventType::Allocate:  return "allocate";
+                case TraceEventType::Free:      return "free";
+                case TraceEventType::Fork:      return "fork";
+                case TraceEventType::IOEnqueue: return "io_enqueue";
+                case TraceEventType::IOServe:   return "io_serve";
+            }
+
+            return "unknown";
+        }
+
+        std::FILE * trace_file{ nullptr };
+        std::vector<TraceEvent> events;
+        std::chrono::steady_clock::time_point start_time;
+        bool first_entry{ true };
+        size_t track_core_count{ 1 };
+
+};
+
+#endif // TRACER_H_
@@ -2,18 +2,85 @@
 /// @file CS OS Home Project - main.cpp
 /// @date 2020-04-14
 /// @brief Main function which accepts RAM size and HDD count
-/// for simulated OS, then creates OS object and calls run()
-/// to begin simulated operating system.
+/// for simulated OS, then creates OS object and runs the console
+/// front end on it to begin simulated operating system. The NUMA
+/// topology is optional and given on the command line. With --socket,
+/// commands are taken from several producers connecting to a Unix
+/// domain socket (see Ingest.h) instead of from the console:
+///
+///     ./main [--nodes <#>] [--cores <#>] [--socket <path> [--producers <#>]]
 
 #include <iostream>
+#include <string>
 
 #include "DataTypes.h"
 #include "OS.h"
+#include "Console.h"
+#include "Ingest.h"
 
-int main() {
+/**
+ * Reads the value of a numeric command line option.
+ *
+ * @param text Option value to parse
+ * @param value Parsed value (must be > 0)
+ *
+ * @return False if value is not a positive integer, else true
+ */
+bool parseOptionValue(const char * text, uint & value) {
+    try {
+        size_t parsed{ 0 };
+        unsigned long number{ std::stoul(text, &parsed) };
+
+        if ( text[parsed] != '\0' || ! number || number > static_cast<uint>(-1) ) {
+            return false;
+        }
+
+        value = number;
+        return true;
+    }
+    catch ( const std::exception & ) {
+        return false;
+    }
+}
+
+int main(int argc, char * argv[]) {
+
+    // Snapshots can be very large, let std::cout buffer them
+    std::ios::sync_with_stdio(false);
 
     uint RAM_size{ 0 };
     uint HDD_count{ 0 };
+    uint node_count{ 1 };
+    uint core_count{ 1 };
+    uint producer_count{ 1 };
+    std::string socket_path{ "" };
+
+    for (int i{1}; i < argc; i += 2) {
+        std::string option{ argv[i] };
+        bool valid{ i + 1 < argc };
+
+        if ( valid && option == "--nodes" ) {
+            valid = parseOptionValue(argv[i + 1], node_count);
+        }
+        else if ( valid && option == "--cores" ) {
+            valid = parseOptionValue(argv[i + 1], core_count);
+        }
+        else if ( valid && option == "--producers" ) {
+            valid = parseOptionValue(argv[i + 1], producer_count);
+        }
+        else if ( valid && option == "--socket" ) {
+            socket_path = argv[i + 1];
+        }
+        else {
+            valid = false;
+        }
+
+        if ( ! valid ) {
+            std::cerr << "Usage: " << argv[0] << " [--nodes <#>] [--cores <#>]"
+                      << " [--socket <path> [--producers <#>]]" << std::endl;
+            return 1;
+        }
+    }
 
     std::cout << "\n\tHow much RAM (in bytes) should the simulated computer use?\n\n>> ";
     std::cin >> RAM_size;
@@ -21,8 +88,24 @@ int main() {
     std::cout << "\n\tHow many HDDs should the simulated computer use?\n\n>> ";
     std::cin >> HDD_count;
 
-    OS os(RAM_size, HDD_count);
-    os.run();
+    OS os(RAM_size, HDD_count, node_count, core_count);
+    Console console(os);
+
+    if ( socket_path.empty() ) {
+        console.run();
+        return 0;
+    }
+
+    IngestServer server(console, producer_count);
+
+    std::cout << "\n\tWaiting for " << producer_count << " producer(s) on " << socket_path << '\n' << std::endl;
+
+    if ( ! server.run(socket_path) ) {
+        std::cerr << "\n\tError - Could not listen on socket: " << socket_path << '\n' << std::endl;
+        return 1;
+    }
+
+    server.printStatistics();
 
     return 0;
 }